@@ -7,27 +7,35 @@
 #include <windows.h>
 
 #include "ImGui/imgui.h"
-#include "ImGui/imgui_sdl.h"
 #include "ImGui/imgui_impl_sdl.h"
+#include "ImGui/imgui_impl_sdlrenderer.h"
 
+#include "src/benchmark.h"
 #include "src/dataStructuresAndMethods.h"
 #include "src/debugDrawer.h"
 #include "src/enemyBase.h"
 #include "src/enemyManager.h"
+#include "src/fontRegistry.h"
 #include "src/gameEngine.h"
 #include "src/imGuiManager.h"
+#include "src/layeredSpatialIndex.h"
 #include "src/obstacleManager.h"
 #include "src/playerCharacter.h"
 #include "src/projectileManager.h"
 #include "src/quadTree.h"
 #include "src/rayCast.h"
+#include "src/spatialHashGrid.h"
+#include "src/spriteBatcher.h"
 #include "src/sprite.h"
 #include "src/spriteSheet.h"
 #include "src/stateStack.h"
 #include "src/steeringBehavior.h"
+#include "src/sweepAndPrune.h"
 #include "src/timerManager.h"
 #include "src/textSprite.h"
+#include "src/textureCache.h"
 #include "src/vector2.h"
+#include "src/visibilityCuller.h"
 
 int main(int argc, char* argv[]) {
 	HWND windowHandle = GetConsoleWindow();
@@ -39,6 +47,19 @@ int main(int argc, char* argv[]) {
 
 	window = SDL_CreateWindow("Game", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, windowWidth, windowHeight, 0);	
 	renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+	//Made first, since everything that is made after it loads its sprites through it
+	textureCache = std::make_shared<TextureCache>();
+	spriteBatcher = std::make_shared<SpriteBatcher>(renderer);
+	//All the sprites are packed in one texture, so a whole frame of them can be drawn from it
+	textureCache->BuildAtlas("res/sprites");
+	//Has to be there before the buttons and the player make their text
+	fontRegistry = std::make_shared<FontRegistry>();
+	//Has to be known before anything below loads its sprites
+	for (int i = 1; i < argc; i++) {
+		if (std::string(argv[i]) == "--prerotate") {
+			textureCache->SetPreRotationAngles(64);
+		}
+	}
 
 	enemyManager = std::make_shared<EnemyManager>();
 	gameStateHandler = std::make_shared<GameStateHandler>();
@@ -48,15 +69,65 @@ int main(int argc, char* argv[]) {
 	projectileManager = std::make_shared<ProjectileManager>();
 	playerCharacter = std::make_shared<PlayerCharacter>(0.f, 0, Vector2<float>(windowWidth * 0.5f, windowHeight * 0.5f));
 	rayCast = std::make_shared<RayCast>();
+	visibilityCuller = std::make_shared<VisibilityCuller>();
 
 	timerManager = std::make_shared<TimerManager>();
 	separationBehavior = std::make_shared<SeparationBehavior>();
 
+	bool runBenchmark = false;
+	bool useSpatialHashGrid = false;
+	bool useQuadTree = false;
+	bool useSweepAndPrune = false;
+	bool useBatchSteering = false;
+	for (int i = 1; i < argc; i++) {
+		if (std::string(argv[i]) == "--benchmark") {
+			runBenchmark = true;
+		} else if (std::string(argv[i]) == "--hashgrid") {
+			useSpatialHashGrid = true;
+		} else if (std::string(argv[i]) == "--quadtree") {
+			useQuadTree = true;
+		} else if (std::string(argv[i]) == "--sweepandprune") {
+			useSweepAndPrune = true;
+		} else if (std::string(argv[i]) == "--batchsteering") {
+			useBatchSteering = true;
+		}
+	}
+	enemyManager->SetBatchSteering(useBatchSteering);
+
 	QuadTreeNode quadTreeNode;
 	quadTreeNode.rectangle = AABB::makeFromPositionSize(
 		Vector2(windowWidth * 0.5f, windowHeight * 0.5f), windowHeight, windowWidth);
-	objectBaseQuadTree = std::make_shared<QuadTree<std::shared_ptr<ObjectBase>>>(quadTreeNode, 10);
-
+	//Every collision layer gets its own index of the chosen type
+	objectBaseQuadTree = std::make_shared<LayeredSpatialIndex<std::shared_ptr<ObjectBase>>>(
+		[quadTreeNode, useSpatialHashGrid, useQuadTree, useSweepAndPrune]() -> std::shared_ptr<SpatialIndex<std::shared_ptr<ObjectBase>>> {
+		if (useSpatialHashGrid) {
+			//The cells are as wide as the biggest enemy, so a query only has to look at the cells right next to it
+			return std::make_shared<SpatialHashGrid<std::shared_ptr<ObjectBase>>>(quadTreeNode.rectangle, 32.f);
+		}
+		if (useSweepAndPrune) {
+			//Keeps the objects sorted along x between frames, and finds the projectile hits in one sweep
+			return std::make_shared<SweepAndPrune<std::shared_ptr<ObjectBase>>>();
+		}
+		if (useQuadTree) {
+			//Rebuilt from scratch every frame with BulkUpdate
+			return std::make_shared<QuadTree<std::shared_ptr<ObjectBase>>>(quadTreeNode, 16, 8);
+		}
+		//The loose quadtree keeps the objects between frames and only moves the ones that leave their node
+		return std::make_shared<LooseQuadTree<std::shared_ptr<ObjectBase>>>(quadTreeNode, 5);
+	});
+
+	//Runs the benchmarks instead of the game and writes the results to benchmark.txt
+	if (runBenchmark) {
+		Benchmark benchmark;
+		benchmark.RunAll();
+		benchmark.WriteResults("benchmark.txt");
+		fontRegistry->Shutdown();
+		textureCache->Shutdown();
+		SDL_DestroyRenderer(renderer);
+		SDL_DestroyWindow(window);
+		SDL_Quit();
+		return 0;
+	}
 
 
 	//Init here
@@ -65,13 +136,14 @@ int main(int argc, char* argv[]) {
 	playerCharacter->Init();
 	projectileManager->Init();
 
-	//objectBaseQuadTree->Insert(playerCharacter, playerCharacter->GetCircleCollider());
+	//objectBaseQuadTree->Insert(CollisionLayer::Player, playerCharacter, playerCharacter->GetCircleCollider());
 
 	gameStateHandler->AddState(std::make_shared<MenuState>());
 
 	Uint64 previous_ticks = SDL_GetPerformanceCounter();
 	runningGame = true;
 	while (runningGame) {
+		ImGui_ImplSDLRenderer_NewFrame();
 		ImGui_ImplSDL2_NewFrame(window);
 		ImGui::NewFrame();
 
@@ -128,12 +200,18 @@ int main(int argc, char* argv[]) {
 		//Render images here
 		gameStateHandler->RenderState();
 
+		//The channels can be turned on in the Debug drawing window, the spatial index only adds its shapes when its channel is on
+		debugDrawer->ShowChannels();
+		imGuiHandler->ShowPerformance();
+		if (debugDrawer->IsChannelEnabled(DebugChannel::SpatialIndex)) {
+			objectBaseQuadTree->Render();
+		}
 		debugDrawer->DrawBoxes();
 		debugDrawer->DrawRectangles();
 		debugDrawer->DrawCircles();
 		debugDrawer->DrawLines();
 
-		objectBaseQuadTree->Clear();
+		objectBaseQuadTree->EndFrame();
 
 		//Render text here
 		gameStateHandler->RenderStateText();
@@ -144,6 +222,8 @@ int main(int argc, char* argv[]) {
 		SDL_Delay(16);
 	}
 	imGuiHandler->ShutDown();
+	fontRegistry->Shutdown();
+	textureCache->Shutdown();
 	SDL_DestroyWindow(window);
 	SDL_Quit();
 	std::exit(0);
@@ -0,0 +1,1428 @@
+#include "benchmark.h"
+
+#include "collision.h"
+#include "enemyBase.h"
+#include "gameEngine.h"
+#include "ImGui/imgui.h"
+#include "ImGui/imgui_impl_sdlrenderer.h"
+#include "ImGui/imgui_sdl.h"
+#include "neighborList.h"
+#include "objectPool.h"
+#include "obstacleManager.h"
+#include "obstacleWall.h"
+#include "quadTree.h"
+#include "rotatedSprite.h"
+#include "slabPool.h"
+#include "sprite.h"
+#include "spriteBatcher.h"
+#include "spatialHashGrid.h"
+#include "steeringBehavior.h"
+#include "steeringEngine.h"
+#include "sweepAndPrune.h"
+#include "textureCache.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <random>
+
+namespace {
+	std::atomic<unsigned long long> allocationCount = 0;
+#ifdef COUNT_ALLOCATIONS
+	const bool countingAllocations = true;
+#else
+	const bool countingAllocations = false;
+#endif
+}
+
+/*Counts every allocation made with new, so the benchmarks can show how many allocations a loop makes.
+Replacing operator new replaces it for the whole program, so it's only compiled in when COUNT_ALLOCATIONS is defined
+and the game is built the usual way with the allocator left alone. Without it allocationCount just stays at zero*/
+#ifdef COUNT_ALLOCATIONS
+void* operator new(std::size_t size) {
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	void* pointer = std::malloc(size > 0 ? size : 1);
+	if (!pointer) {
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+#endif
+
+namespace {
+	/*The quadtree as it was before it was moved to flat arrays.
+	It's only kept here so the benchmark has something to compare against*/
+	template<typename T>
+	class PointerQuadTree {
+	public:
+		PointerQuadTree(QuadTreeNode boundary, unsigned int capacity) : _quadTreeNode(boundary), _capacity(capacity) {}
+
+		bool Insert(T object, Circle circleCollider) {
+			if (!_quadTreeNode.Contains(circleCollider)) {
+				return false;
+			}
+			if (_objectsInserted.size() < _capacity) {
+				_objectsInserted.emplace_back(object);
+				_circleColliders.emplace_back(circleCollider);
+				return true;
+			}
+			if (!_divided) {
+				Subdevide();
+			}
+			for (unsigned int i = 0; i < _quadTreeChildren.size(); i++) {
+				if (_quadTreeChildren[i]->Insert(object, circleCollider)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		std::vector<T> Query(Circle range) {
+			std::vector<T> objectsFound;
+			if (_quadTreeNode.Intersect(range)) {
+				for (unsigned int i = 0; i < _objectsInserted.size(); i++) {
+					if (CircleIntersect(range, _circleColliders[i])) {
+						objectsFound.emplace_back(_objectsInserted[i]);
+					}
+				}
+				if (_divided) {
+					std::vector<T> objectsFoundInChild;
+					for (unsigned int i = 0; i < _quadTreeChildren.size(); i++) {
+						objectsFoundInChild = _quadTreeChildren[i]->Query(range);
+						objectsFound.insert(objectsFound.end(), objectsFoundInChild.begin(), objectsFoundInChild.end());
+					}
+				}
+			}
+			return objectsFound;
+		}
+
+		void Clear() {
+			_objectsInserted.clear();
+			_circleColliders.clear();
+			for (unsigned int i = 0; i < _quadTreeChildren.size(); i++) {
+				_quadTreeChildren[i] = nullptr;
+			}
+			_divided = false;
+		}
+
+	private:
+		void Subdevide() {
+			const AABB rectangle = _quadTreeNode.rectangle;
+			const std::array<Vector2<float>, 4> childOffsets = {
+				Vector2<float>(-0.25f, -0.25f), Vector2<float>(0.25f, -0.25f),
+				Vector2<float>(-0.25f, 0.25f), Vector2<float>(0.25f, 0.25f)
+			};
+			for (unsigned int i = 0; i < childOffsets.size(); i++) {
+				QuadTreeNode child;
+				child.rectangle = AABB::makeFromPositionSize(Vector2<float>(
+					rectangle.position.x + (rectangle.width * childOffsets[i].x),
+					rectangle.position.y + (rectangle.height * childOffsets[i].y)),
+					rectangle.height * 0.5f, rectangle.width * 0.5f);
+				_quadTreeChildren[i] = std::make_shared<PointerQuadTree<T>>(child, _capacity);
+			}
+			_divided = true;
+		}
+
+		QuadTreeNode _quadTreeNode;
+		unsigned int _capacity = 0;
+		bool _divided = false;
+
+		std::array<std::shared_ptr<PointerQuadTree<T>>, 4> _quadTreeChildren;
+		std::vector<T> _objectsInserted;
+		std::vector<Circle> _circleColliders;
+	};
+
+	//Same radius as the human and boar enemies, spread over the whole window
+	std::vector<Circle> CreateColliders(unsigned int count, std::mt19937& engine) {
+		std::uniform_real_distribution<float> distX(0.f, windowWidth);
+		std::uniform_real_distribution<float> distY(0.f, windowHeight);
+		std::vector<Circle> colliders(count);
+		for (unsigned int i = 0; i < count; i++) {
+			colliders[i].position = Vector2<float>(distX(engine), distY(engine));
+			colliders[i].radius = i % 3 == 0 ? 16.f : 12.f;
+		}
+		return colliders;
+	}
+
+	/*Puts a part of the colliders in a few tight groups, the way enemies bunch up around the player.
+	0 gives the same spread as CreateColliders, 1 puts every collider in a group*/
+	std::vector<Circle> CreateClusteredColliders(unsigned int count, float clustering, std::mt19937& engine) {
+		std::vector<Circle> colliders = CreateColliders(count, engine);
+		std::uniform_real_distribution<float> distX(windowWidth * 0.1f, windowWidth * 0.9f);
+		std::uniform_real_distribution<float> distY(windowHeight * 0.1f, windowHeight * 0.9f);
+		std::uniform_real_distribution<float> chance(0.f, 1.f);
+		std::normal_distribution<float> spread(0.f, 40.f);
+		std::array<Vector2<float>, 4> clusterCenters;
+		for (unsigned int i = 0; i < clusterCenters.size(); i++) {
+			clusterCenters[i] = Vector2<float>(distX(engine), distY(engine));
+		}
+		for (unsigned int i = 0; i < count; i++) {
+			if (chance(engine) < clustering) {
+				const Vector2<float> center = clusterCenters[i % clusterCenters.size()];
+				colliders[i].position = Vector2<float>(center.x + spread(engine), center.y + spread(engine));
+			}
+		}
+		return colliders;
+	}
+
+	std::vector<std::shared_ptr<unsigned int>> CreateObjects(unsigned int count) {
+		std::vector<std::shared_ptr<unsigned int>> objects(count);
+		for (unsigned int i = 0; i < count; i++) {
+			objects[i] = std::make_shared<unsigned int>(i);
+		}
+		return objects;
+	}
+
+	//Written to after every query so the compiler can't remove the work that is being measured
+	volatile size_t objectsFoundSink = 0;
+
+	QuadTreeNode WindowBoundary() {
+		QuadTreeNode quadTreeNode;
+		quadTreeNode.rectangle = AABB::makeFromPositionSize(
+			Vector2<float>(windowWidth * 0.5f, windowHeight * 0.5f), windowHeight, windowWidth);
+		return quadTreeNode;
+	}
+
+	//Times filling the index from empty and then querying it once for every entity
+	template<typename Index>
+	void MeasureBuildAndQuery(Index& index, const std::vector<Circle>& colliders,
+		const std::vector<std::shared_ptr<unsigned int>>& objects, unsigned int iterations, double& buildMilliseconds, double& queryMilliseconds) {
+		const double frequency = (double)SDL_GetPerformanceFrequency();
+		Uint64 startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int k = 0; k < iterations; k++) {
+			index.Clear();
+			for (unsigned int j = 0; j < colliders.size(); j++) {
+				index.Insert(objects[j], colliders[j]);
+			}
+		}
+		buildMilliseconds = (double)(SDL_GetPerformanceCounter() - startTicks) * 1000.0 / frequency / iterations;
+
+		std::vector<std::shared_ptr<unsigned int>> objectsFound;
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int j = 0; j < colliders.size(); j++) {
+			index.Query(colliders[j], objectsFound);
+			objectsFoundSink = objectsFoundSink + objectsFound.size();
+		}
+		queryMilliseconds = (double)(SDL_GetPerformanceCounter() - startTicks) * 1000.0 / frequency;
+	}
+
+	//Times the nearest, screen rectangle and ray queries from a set of positions on an index that is already filled
+	template<typename Index>
+	void MeasureSpatialQueries(Index& index, const std::vector<Vector2<float>>& positions, const std::vector<Ray>& rays,
+		double& nearestMilliseconds, double& rangeMilliseconds, double& rayMilliseconds) {
+		const double frequency = (double)SDL_GetPerformanceFrequency();
+		std::vector<NearestObject<std::shared_ptr<unsigned int>>> nearestObjects;
+		Uint64 startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int i = 0; i < positions.size(); i++) {
+			index.QueryNearest(positions[i], 4, 300.f, nearestObjects);
+			objectsFoundSink = objectsFoundSink + nearestObjects.size();
+		}
+		nearestMilliseconds = (double)(SDL_GetPerformanceCounter() - startTicks) * 1000.0 / frequency;
+
+		std::vector<std::shared_ptr<unsigned int>> objectsFound;
+		const AABB screen = WindowBoundary().rectangle;
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int i = 0; i < 10; i++) {
+			index.QueryRange(screen, objectsFound);
+			objectsFoundSink = objectsFoundSink + objectsFound.size();
+		}
+		rangeMilliseconds = (double)(SDL_GetPerformanceCounter() - startTicks) * 1000.0 / frequency / 10;
+
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int i = 0; i < rays.size(); i++) {
+			objectsFoundSink = objectsFoundSink + (index.QueryRay(rays[i]).objectHit ? 1 : 0);
+		}
+		rayMilliseconds = (double)(SDL_GetPerformanceCounter() - startTicks) * 1000.0 / frequency;
+	}
+
+	//Moves the collider by its velocity, and puts it back on the other side of the window when it leaves
+	void MoveAndWrap(Circle& circleCollider, Vector2<float> velocity) {
+		circleCollider.position += velocity;
+		if (circleCollider.position.x < 0.f) {
+			circleCollider.position.x += windowWidth;
+		} else if (circleCollider.position.x > windowWidth) {
+			circleCollider.position.x -= windowWidth;
+		}
+		if (circleCollider.position.y < 0.f) {
+			circleCollider.position.y += windowHeight;
+		} else if (circleCollider.position.y > windowHeight) {
+			circleCollider.position.y -= windowHeight;
+		}
+	}
+
+	/*Plays a number of frames where the enemies drift slowly and the projectiles fly in straight lines.
+	Every frame the enemies are updated in the index and all projectile and enemy overlaps are found with QueryPairs.
+	Only the index work is timed, and the number of pairs is returned so the backends can be checked against each other*/
+	template<typename Index>
+	double MeasureProjectileFrames(Index& index, std::vector<Circle> enemies, std::vector<Circle> projectiles,
+		const std::vector<Vector2<float>>& enemyVelocities, const std::vector<Vector2<float>>& projectileVelocities,
+		const std::vector<std::shared_ptr<unsigned int>>& objects, unsigned int frames, unsigned int& pairsFound) {
+		index.Clear();
+		std::vector<int> handles(enemies.size(), -1);
+		std::vector<CollisionPair<std::shared_ptr<unsigned int>>> pairs;
+		pairsFound = 0;
+		const double frequency = (double)SDL_GetPerformanceFrequency();
+		Uint64 elapsedTicks = 0;
+		for (unsigned int frame = 0; frame < frames; frame++) {
+			for (unsigned int i = 0; i < enemies.size(); i++) {
+				MoveAndWrap(enemies[i], enemyVelocities[i]);
+			}
+			for (unsigned int i = 0; i < projectiles.size(); i++) {
+				MoveAndWrap(projectiles[i], projectileVelocities[i]);
+			}
+			const Uint64 startTicks = SDL_GetPerformanceCounter();
+			index.BulkUpdate(objects, enemies, handles);
+			index.QueryPairs(projectiles, pairs);
+			index.EndFrame();
+			elapsedTicks += SDL_GetPerformanceCounter() - startTicks;
+			pairsFound += pairs.size();
+		}
+		return (double)elapsedTicks * 1000.0 / frequency / frames;
+	}
+
+	//About as big as a projectile, most of it is never touched by the update
+	struct MovingObject {
+		Circle collider;
+		Vector2<float> velocity;
+		char payload[160] = {};
+	};
+
+	//Moves every object once per frame in the order they are in the vector, and returns the milliseconds per frame
+	double MeasureMovingObjects(std::vector<std::shared_ptr<MovingObject>>& objects, unsigned int frames) {
+		const Uint64 startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int frame = 0; frame < frames; frame++) {
+			for (unsigned int i = 0; i < objects.size(); i++) {
+				MoveAndWrap(objects[i]->collider, objects[i]->velocity);
+			}
+		}
+		return (double)(SDL_GetPerformanceCounter() - startTicks) * 1000.0 / (double)SDL_GetPerformanceFrequency() / frames;
+	}
+
+	struct PooledObject {
+		unsigned int objectID = 0;
+		PoolHandle poolHandle;
+	};
+
+	/*How the managers removed an object before the object pool kept track of the spawned ones.
+	The active objects were sorted on their ID with this quicksort before every removal, and then the object was found with a binary search*/
+	class SortedRemoval {
+	public:
+		std::vector<std::shared_ptr<PooledObject>> activeObjects;
+		std::vector<std::shared_ptr<PooledObject>> pooledObjects;
+
+		void Remove(unsigned int objectID) {
+			if (activeObjects.size() > 1) {
+				QuickSort(0, activeObjects.size() - 1);
+				const int index = BinarySearch(0, activeObjects.size() - 1, objectID);
+				if (index < 0) {
+					return;
+				}
+				std::swap(activeObjects[index], activeObjects.back());
+			}
+			pooledObjects.emplace_back(activeObjects.back());
+			activeObjects.pop_back();
+		}
+
+	private:
+		int BinarySearch(int low, int high, unsigned int objectID) {
+			while (low <= high) {
+				int mid = low + (high - low) / 2;
+				if (activeObjects[mid]->objectID == objectID) {
+					return mid;
+				}
+				if (activeObjects[mid]->objectID < objectID) {
+					low = mid + 1;
+				} else {
+					high = mid - 1;
+				}
+			}
+			return -1;
+		}
+
+		int Partition(int start, int end) {
+			unsigned int pivot = activeObjects[start]->objectID;
+			int count = 0;
+			for (int i = start + 1; i <= end; i++) {
+				if (activeObjects[i]->objectID <= pivot) {
+					count++;
+				}
+			}
+			int pivotIndex = start + count;
+			std::swap(activeObjects[pivotIndex], activeObjects[start]);
+			int i = start, k = end;
+			while (i < pivotIndex && k > pivotIndex) {
+				while (activeObjects[i]->objectID <= pivot) {
+					i++;
+				}
+				while (activeObjects[k]->objectID > pivot) {
+					k--;
+				}
+				if (i < pivotIndex && k > pivotIndex) {
+					std::swap(activeObjects[i++], activeObjects[k--]);
+				}
+			}
+			return pivotIndex;
+		}
+
+		void QuickSort(int start, int end) {
+			if (start >= end) {
+				return;
+			}
+			int p = Partition(start, end);
+			QuickSort(start, p - 1);
+			QuickSort(p + 1, end);
+		}
+	};
+
+	//The steering parameters the boar and human constructors set
+	SteeringArchetype BoarArchetype() {
+		SteeringArchetype steeringArchetype;
+		BehaviorData& behaviorData = steeringArchetype.behaviorData;
+		behaviorData.angularSlowDownRadius = PI * 0.5f;
+		behaviorData.angularTargetRadius = PI * 0.005f;
+		behaviorData.maxAngularAcceleration = PI * 2.5f;
+		behaviorData.maxRotation = PI * 2.f;
+		behaviorData.timeToTarget = 0.1f;
+		behaviorData.maxLinearAcceleration = 75.f;
+		behaviorData.maxSpeed = 100.f;
+		behaviorData.linearTargetRadius = 95.f;
+		behaviorData.linearSlowDownRadius = 125.f;
+		behaviorData.separationThreshold = 16.f * 1.5f;
+		behaviorData.decayCoefficient = 1.f;
+		steeringArchetype.separationFirst = true;
+		return steeringArchetype;
+	}
+
+	SteeringArchetype HumanArchetype() {
+		SteeringArchetype steeringArchetype;
+		BehaviorData& behaviorData = steeringArchetype.behaviorData;
+		behaviorData.angularSlowDownRadius = PI * 0.5f;
+		behaviorData.angularTargetRadius = PI * 0.005f;
+		behaviorData.maxAngularAcceleration = PI * 2.5f;
+		behaviorData.maxRotation = PI * 2.f;
+		behaviorData.timeToTarget = 0.1f;
+		behaviorData.maxLinearAcceleration = 75.f;
+		behaviorData.maxSpeed = 75.f;
+		behaviorData.separationThreshold = 12.f * 1.5f;
+		behaviorData.decayCoefficient = 10000.f;
+		return steeringArchetype;
+	}
+
+	//Just enough of an enemy for the steering behaviors, with the same PrioritySteering groups as the boar or human
+	class SteeringEnemy : public EnemyBase {
+	public:
+		SteeringEnemy(unsigned int objectID, EnemyType enemyType, const SteeringArchetype& steeringArchetype, Circle collider) : EnemyBase(objectID, enemyType) {
+			_behaviorData = steeringArchetype.behaviorData;
+			_separationFirst = steeringArchetype.separationFirst;
+			_circleCollider = collider;
+			_position = collider.position;
+			_prioritySteering = std::make_shared<PrioritySteering>();
+			_blendSteering = std::make_shared<BlendSteering>();
+			_blendSteering->AddSteeringBehaviour(BehaviorAndWeight(std::make_shared<SeparationBehavior>(), 1.f));
+			if (_separationFirst) {
+				_prioritySteering->AddGroup(*_blendSteering);
+			}
+			_blendSteering->AddSteeringBehaviour(BehaviorAndWeight(std::make_shared<ArriveBehavior>(), 1.f));
+			_blendSteering->AddSteeringBehaviour(BehaviorAndWeight(std::make_shared<FaceBehavior>(), 1.f));
+			_prioritySteering->AddGroup(*_blendSteering);
+		}
+
+		void Init() override {}
+		void Update() override {}
+		void Render() override {}
+		void RenderText() override {}
+
+		const ObjectType GetObjectType() const override { return ObjectType::Enemy; }
+		const std::shared_ptr<Sprite> GetSprite() const override { return nullptr; }
+		const unsigned int GetObjectID() const override { return _objectID; }
+		const Vector2<float> GetPosition() const override { return _position; }
+
+		bool TakeDamage(unsigned int damageAmount) override { return false; }
+
+		const Circle GetCollider() const override { return _circleCollider; }
+		const EnemyType GetEnemyType() const override { return _enemyType; }
+		const float GetOrientation() const override { return _orientation; }
+		const float GetRotation() const override { return _rotation; }
+		const int GetCurrentHealth() const override { return _currentHealth; }
+		const BehaviorData& GetBehaviorData() const override { return _behaviorData; }
+		const Vector2<float> GetVelocity() const override { return _velocity; }
+		const std::vector<std::shared_ptr<ObjectBase>>& GetQueriedObjects() const override { return _queriedObjects; }
+		const std::shared_ptr<WeaponComponent> GetWeaponComponent() const override { return nullptr; }
+
+		void ActivateEnemy(float orienation, Vector2<float> direction, Vector2<float> position) override {}
+		void DeactivateEnemy() override {}
+		void HandleAttack() override {}
+
+		void SetPosition(Vector2<float> position) override { _position = position; }
+		void SetTargetPosition(Vector2<float> targetPosition) override { _behaviorData.targetPosition = targetPosition; }
+		void SetTargetOrientation(float targetOrientation) override { _behaviorData.targetOrientation = targetOrientation; }
+		void SetVelocity(Vector2<float> velocity) override { _velocity = velocity; }
+
+		void SetOrientation(float orientation) { _orientation = orientation; }
+		void SetNeighbors(const std::vector<std::shared_ptr<ObjectBase>>& neighbors) { _queriedObjects = neighbors; }
+		const SteeringOutput Steer() {
+			_steeringOutput = _prioritySteering->Steering(_behaviorData, *this);
+			return _steeringOutput;
+		}
+	};
+
+	//Boars and humans spread over the screen heading for target, every one of them already has its neighbors the way UpdateNeighbors leaves them
+	std::vector<std::shared_ptr<SteeringEnemy>> CreateSteeringCrowd(unsigned int count, Vector2<float> target, std::mt19937& engine) {
+		std::uniform_real_distribution<float> angle(-PI, PI);
+		std::uniform_real_distribution<float> speed(0.f, 75.f);
+		std::vector<Circle> colliders = CreateColliders(count, engine);
+		std::vector<std::shared_ptr<SteeringEnemy>> enemies;
+		std::vector<std::shared_ptr<ObjectBase>> objects;
+		for (unsigned int i = 0; i < count; i++) {
+			const bool boar = i % 3 == 0;
+			enemies.emplace_back(std::make_shared<SteeringEnemy>(i + 1, boar ? EnemyType::Boar : EnemyType::Human,
+				boar ? BoarArchetype() : HumanArchetype(), colliders[i]));
+			const float direction = angle(engine);
+			enemies.back()->SetVelocity(Vector2<float>(std::cos(direction), std::sin(direction)) * speed(engine));
+			enemies.back()->SetOrientation(angle(engine));
+			enemies.back()->SetTargetPosition(target);
+			objects.emplace_back(enemies.back());
+		}
+		LooseQuadTree<std::shared_ptr<ObjectBase>> looseQuadTree(WindowBoundary(), 5);
+		std::vector<int> handles(count, -1);
+		looseQuadTree.BulkUpdate(objects, colliders, handles);
+		std::vector<std::shared_ptr<ObjectBase>> neighbors;
+		for (unsigned int i = 0; i < count; i++) {
+			looseQuadTree.Query(colliders[i], neighbors);
+			enemies[i]->SetNeighbors(neighbors);
+		}
+		return enemies;
+	}
+
+	//How GetQueriedObjects and GetWalls used to hand out their lists, a new copy every time they were called
+	std::vector<std::shared_ptr<ObjectBase>> CopyQueriedObjects(const EnemyBase& enemy) {
+		return enemy.GetQueriedObjects();
+	}
+
+	std::vector<std::shared_ptr<Wall>> CopyWalls(const ObstacleManager& obstacleManager) {
+		return obstacleManager.GetWalls();
+	}
+
+	//SeparationBehavior the way it was written before, calling the copying accessor in the loop condition and for every neighbor
+	Vector2<float> CopyingSeparation(const EnemyBase& enemy) {
+		Vector2<float> linearVelocity = { 0.f, 0.f };
+		const BehaviorData& behaviorData = enemy.GetBehaviorData();
+		for (unsigned int i = 0; i < CopyQueriedObjects(enemy).size(); i++) {
+			if (enemy.GetObjectID() == CopyQueriedObjects(enemy)[i]->GetObjectID()) {
+				continue;
+			}
+			Vector2<float> direction = CopyQueriedObjects(enemy)[i]->GetPosition() - enemy.GetPosition();
+			const float distance = direction.absolute();
+			if (distance < behaviorData.separationThreshold) {
+				const float strength = std::min(behaviorData.decayCoefficient / (distance * distance), behaviorData.maxLinearAcceleration);
+				direction.normalize();
+				linearVelocity -= direction * strength;
+			}
+		}
+		return linearVelocity;
+	}
+}
+
+void Benchmark::RunAll() {
+	_results.clear();
+	QuadTreeBenchmark();
+	BroadphaseBenchmark();
+	QuadTreeCapacityBenchmark();
+	SpatialQueryBenchmark();
+	QuadTreeBulkBuildBenchmark();
+	ProjectilePairBenchmark();
+	NeighborListBenchmark();
+	ObjectPoolBenchmark();
+	SlabPoolBenchmark();
+	TextureCacheBenchmark();
+	SpriteBatchBenchmark();
+	PreRotatedSpriteBenchmark();
+	ImGuiRenderBenchmark();
+	SteeringBenchmark();
+	AccessorAllocationBenchmark();
+}
+
+//Builds and queries both quadtrees the same way the game does every frame
+void Benchmark::QuadTreeBenchmark() {
+	std::mt19937 engine(1234);
+	for (unsigned int i = 0; i < _entityCounts.size(); i++) {
+		const unsigned int entityCount = _entityCounts[i];
+		std::vector<Circle> colliders = CreateColliders(entityCount, engine);
+		std::vector<std::shared_ptr<unsigned int>> objects = CreateObjects(entityCount);
+
+		PointerQuadTree<std::shared_ptr<unsigned int>> pointerQuadTree(WindowBoundary(), 10);
+		QuadTree<std::shared_ptr<unsigned int>> flatQuadTree(WindowBoundary(), 10);
+
+		Uint64 startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int k = 0; k < _iterations; k++) {
+			pointerQuadTree.Clear();
+			for (unsigned int j = 0; j < entityCount; j++) {
+				pointerQuadTree.Insert(objects[j], colliders[j]);
+			}
+		}
+		AddResult("QuadTree (pointer) build", entityCount, GetElapsedMilliseconds(startTicks) / _iterations);
+
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int k = 0; k < _iterations; k++) {
+			flatQuadTree.Clear();
+			for (unsigned int j = 0; j < entityCount; j++) {
+				flatQuadTree.Insert(objects[j], colliders[j]);
+			}
+		}
+		AddResult("QuadTree (flat) build", entityCount, GetElapsedMilliseconds(startTicks) / _iterations);
+
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int j = 0; j < entityCount; j++) {
+			objectsFoundSink = objectsFoundSink + pointerQuadTree.Query(colliders[j]).size();
+		}
+		AddResult("QuadTree (pointer) query all", entityCount, GetElapsedMilliseconds(startTicks));
+
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int j = 0; j < entityCount; j++) {
+			objectsFoundSink = objectsFoundSink + flatQuadTree.Query(colliders[j]).size();
+		}
+		AddResult("QuadTree (flat) query all", entityCount, GetElapsedMilliseconds(startTicks));
+
+		//Same queries, but the vector is kept between them the way the enemies keep their queried objects
+		std::vector<std::shared_ptr<unsigned int>> objectsFound;
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int j = 0; j < entityCount; j++) {
+			flatQuadTree.Query(colliders[j], objectsFound);
+			objectsFoundSink = objectsFoundSink + objectsFound.size();
+		}
+		AddResult("QuadTree (flat) query all, reused buffer", entityCount, GetElapsedMilliseconds(startTicks));
+
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int j = 0; j < entityCount; j++) {
+			size_t objectsFoundCount = 0;
+			flatQuadTree.ForEachInRange(colliders[j], [&objectsFoundCount](const std::shared_ptr<unsigned int>& object, const Circle& circleCollider) {
+				objectsFoundCount++;
+				return true;
+			});
+			objectsFoundSink = objectsFoundSink + objectsFoundCount;
+		}
+		AddResult("QuadTree (flat) query all, callback", entityCount, GetElapsedMilliseconds(startTicks));
+
+		//The loose quadtree is only filled once, after that every entity moves a couple of pixels per frame
+		LooseQuadTree<std::shared_ptr<unsigned int>> looseQuadTree(WindowBoundary(), 5);
+		std::vector<int> handles(entityCount, -1);
+		for (unsigned int j = 0; j < entityCount; j++) {
+			handles[j] = looseQuadTree.Insert(objects[j], colliders[j]);
+		}
+		std::uniform_real_distribution<float> step(-2.f, 2.f);
+		unsigned int relocations = 0;
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int k = 0; k < _iterations; k++) {
+			for (unsigned int j = 0; j < entityCount; j++) {
+				colliders[j].position += Vector2<float>(step(engine), step(engine));
+				handles[j] = looseQuadTree.Update(handles[j], objects[j], colliders[j]);
+			}
+			relocations += looseQuadTree.GetRelocationCount();
+			looseQuadTree.EndFrame();
+		}
+		AddResult("LooseQuadTree update", entityCount, GetElapsedMilliseconds(startTicks) / _iterations);
+		AddResult("LooseQuadTree relocations per frame", entityCount, (double)relocations / _iterations, "relocations");
+	}
+}
+
+//Compares the quadtrees with the hash grid, both with the entities spread out and bunched together
+void Benchmark::BroadphaseBenchmark() {
+	std::mt19937 engine(1234);
+	const std::vector<float> clusteringLevels = { 0.f, 0.5f, 0.9f };
+	for (unsigned int c = 0; c < clusteringLevels.size(); c++) {
+		const std::string clustering = ", " + std::to_string((int)(clusteringLevels[c] * 100.f)) + "% clustered";
+		for (unsigned int i = 0; i < _entityCounts.size(); i++) {
+			const unsigned int entityCount = _entityCounts[i];
+			std::vector<Circle> colliders = CreateClusteredColliders(entityCount, clusteringLevels[c], engine);
+			std::vector<std::shared_ptr<unsigned int>> objects = CreateObjects(entityCount);
+			double buildMilliseconds = 0.0;
+			double queryMilliseconds = 0.0;
+
+			QuadTree<std::shared_ptr<unsigned int>> quadTree(WindowBoundary(), 10);
+			MeasureBuildAndQuery(quadTree, colliders, objects, _iterations, buildMilliseconds, queryMilliseconds);
+			AddResult("QuadTree build" + clustering, entityCount, buildMilliseconds);
+			AddResult("QuadTree query all" + clustering, entityCount, queryMilliseconds);
+
+			LooseQuadTree<std::shared_ptr<unsigned int>> looseQuadTree(WindowBoundary(), 5);
+			MeasureBuildAndQuery(looseQuadTree, colliders, objects, _iterations, buildMilliseconds, queryMilliseconds);
+			AddResult("LooseQuadTree build" + clustering, entityCount, buildMilliseconds);
+			AddResult("LooseQuadTree query all" + clustering, entityCount, queryMilliseconds);
+
+			SpatialHashGrid<std::shared_ptr<unsigned int>> spatialHashGrid(WindowBoundary().rectangle, 32.f);
+			MeasureBuildAndQuery(spatialHashGrid, colliders, objects, _iterations, buildMilliseconds, queryMilliseconds);
+			AddResult("SpatialHashGrid build" + clustering, entityCount, buildMilliseconds);
+			AddResult("SpatialHashGrid query all" + clustering, entityCount, queryMilliseconds);
+		}
+	}
+}
+
+//Builds and queries the quadtree with different capacities at the largest entity count and reports what the tree looks like
+void Benchmark::QuadTreeCapacityBenchmark() {
+	std::mt19937 engine(1234);
+	const unsigned int entityCount = _entityCounts.back();
+	std::vector<Circle> colliders = CreateColliders(entityCount, engine);
+	std::vector<std::shared_ptr<unsigned int>> objects = CreateObjects(entityCount);
+	const std::vector<unsigned int> capacities = { 4, 10, 16, 32, 64 };
+	for (unsigned int i = 0; i < capacities.size(); i++) {
+		const std::string capacity = ", capacity " + std::to_string(capacities[i]);
+		QuadTree<std::shared_ptr<unsigned int>> quadTree(WindowBoundary(), capacities[i]);
+		double buildMilliseconds = 0.0;
+		double queryMilliseconds = 0.0;
+		MeasureBuildAndQuery(quadTree, colliders, objects, _iterations, buildMilliseconds, queryMilliseconds);
+		const QuadTreeStats& stats = quadTree.GetStats();
+		AddResult("QuadTree build" + capacity, entityCount, buildMilliseconds);
+		AddResult("QuadTree query all" + capacity, entityCount, queryMilliseconds);
+		AddResult("QuadTree nodes" + capacity, entityCount, quadTree.GetNodeCount(), "nodes");
+		AddResult("QuadTree straddlers" + capacity, entityCount, quadTree.GetStraddlerCount(), "objects");
+		for (unsigned int depth = 0; depth <= QuadTree<std::shared_ptr<unsigned int>>::maxDepthLimit; depth++) {
+			if (stats.straddlersPerLevel[depth] > 0) {
+				AddResult("QuadTree straddlers at level " + std::to_string(depth) + capacity, entityCount, stats.straddlersPerLevel[depth], "objects");
+			}
+		}
+		AddResult("QuadTree out of bounds inserts" + capacity, entityCount, stats.outOfBoundsInserts, "objects");
+		AddResult("QuadTree nodes visited per query" + capacity, entityCount, (double)stats.nodesVisited / stats.queries, "nodes");
+		AddResult("QuadTree objects tested per query" + capacity, entityCount, (double)stats.objectsTested / stats.queries, "objects");
+	}
+}
+
+//Compares the nearest and ray queries of the indices with checking every entity, the way it would be done without them
+void Benchmark::SpatialQueryBenchmark() {
+	std::mt19937 engine(1234);
+	std::uniform_real_distribution<float> distX(0.f, windowWidth);
+	std::uniform_real_distribution<float> distY(0.f, windowHeight);
+	std::uniform_real_distribution<float> angle(0.f, (float)PI * 2.f);
+	const unsigned int queryCount = 1000;
+	std::vector<Vector2<float>> positions(queryCount);
+	std::vector<Ray> rays(queryCount);
+	for (unsigned int i = 0; i < queryCount; i++) {
+		positions[i] = Vector2<float>(distX(engine), distY(engine));
+		const float rayAngle = angle(engine);
+		rays[i].startPosition = positions[i];
+		rays[i].direction = Vector2<float>(cosf(rayAngle), sinf(rayAngle));
+		rays[i].length = 500.f;
+	}
+	for (unsigned int i = 0; i < _entityCounts.size(); i++) {
+		const unsigned int entityCount = _entityCounts[i];
+		std::vector<Circle> colliders = CreateColliders(entityCount, engine);
+		std::vector<std::shared_ptr<unsigned int>> objects = CreateObjects(entityCount);
+		const std::string queries = ", " + std::to_string(queryCount) + " queries";
+
+		//Every entity is checked for every query and the closest ones are kept
+		std::vector<NearestObject<std::shared_ptr<unsigned int>>> nearestObjects;
+		Uint64 startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int j = 0; j < queryCount; j++) {
+			nearestObjects.clear();
+			for (unsigned int k = 0; k < entityCount; k++) {
+				const float distance = Vector2<float>::distanceBetweenVectors(positions[j], colliders[k].position);
+				if (distance <= 300.f) {
+					AddNearestObject(nearestObjects, 4, objects[k], colliders[k], distance);
+				}
+			}
+			objectsFoundSink = objectsFoundSink + nearestObjects.size();
+		}
+		AddResult("Brute force 4 nearest" + queries, entityCount, GetElapsedMilliseconds(startTicks));
+
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int j = 0; j < queryCount; j++) {
+			RayHit<std::shared_ptr<unsigned int>> rayHit;
+			for (unsigned int k = 0; k < entityCount; k++) {
+				SetClosestRayHit(rayHit, rays[j], objects[k], colliders[k]);
+			}
+			objectsFoundSink = objectsFoundSink + (rayHit.objectHit ? 1 : 0);
+		}
+		AddResult("Brute force ray" + queries, entityCount, GetElapsedMilliseconds(startTicks));
+
+		double nearestMilliseconds = 0.0;
+		double rangeMilliseconds = 0.0;
+		double rayMilliseconds = 0.0;
+		QuadTree<std::shared_ptr<unsigned int>> quadTree(WindowBoundary(), 10);
+		LooseQuadTree<std::shared_ptr<unsigned int>> looseQuadTree(WindowBoundary(), 5);
+		SpatialHashGrid<std::shared_ptr<unsigned int>> spatialHashGrid(WindowBoundary().rectangle, 32.f);
+		for (unsigned int j = 0; j < entityCount; j++) {
+			quadTree.Insert(objects[j], colliders[j]);
+			looseQuadTree.Insert(objects[j], colliders[j]);
+			spatialHashGrid.Insert(objects[j], colliders[j]);
+		}
+		MeasureSpatialQueries(quadTree, positions, rays, nearestMilliseconds, rangeMilliseconds, rayMilliseconds);
+		AddResult("QuadTree 4 nearest" + queries, entityCount, nearestMilliseconds);
+		AddResult("QuadTree screen range", entityCount, rangeMilliseconds);
+		AddResult("QuadTree ray" + queries, entityCount, rayMilliseconds);
+		MeasureSpatialQueries(looseQuadTree, positions, rays, nearestMilliseconds, rangeMilliseconds, rayMilliseconds);
+		AddResult("LooseQuadTree 4 nearest" + queries, entityCount, nearestMilliseconds);
+		AddResult("LooseQuadTree screen range", entityCount, rangeMilliseconds);
+		AddResult("LooseQuadTree ray" + queries, entityCount, rayMilliseconds);
+		MeasureSpatialQueries(spatialHashGrid, positions, rays, nearestMilliseconds, rangeMilliseconds, rayMilliseconds);
+		AddResult("SpatialHashGrid 4 nearest" + queries, entityCount, nearestMilliseconds);
+		AddResult("SpatialHashGrid screen range", entityCount, rangeMilliseconds);
+		AddResult("SpatialHashGrid ray" + queries, entityCount, rayMilliseconds);
+	}
+}
+
+/*Compares inserting the objects one by one with building the whole tree from the morton sorted colliders.
+The same colliders are also built in a shuffled order, which has to give the same tree for the layout to be deterministic*/
+void Benchmark::QuadTreeBulkBuildBenchmark() {
+	std::mt19937 engine(1234);
+	const std::vector<float> clusteringLevels = { 0.f, 0.9f };
+	for (unsigned int c = 0; c < clusteringLevels.size(); c++) {
+		const std::string clustering = ", " + std::to_string((int)(clusteringLevels[c] * 100.f)) + "% clustered";
+		for (unsigned int i = 0; i < _entityCounts.size(); i++) {
+			const unsigned int entityCount = _entityCounts[i];
+			std::vector<Circle> colliders = CreateClusteredColliders(entityCount, clusteringLevels[c], engine);
+			std::vector<std::shared_ptr<unsigned int>> objects = CreateObjects(entityCount);
+			std::vector<int> handles(entityCount, -1);
+			double buildMilliseconds = 0.0;
+			double queryMilliseconds = 0.0;
+
+			QuadTree<std::shared_ptr<unsigned int>> quadTree(WindowBoundary(), 10);
+			MeasureBuildAndQuery(quadTree, colliders, objects, _iterations, buildMilliseconds, queryMilliseconds);
+			AddResult("QuadTree insert build" + clustering, entityCount, buildMilliseconds);
+			AddResult("QuadTree insert query all" + clustering, entityCount, queryMilliseconds);
+
+			Uint64 startTicks = SDL_GetPerformanceCounter();
+			for (unsigned int k = 0; k < _iterations; k++) {
+				quadTree.BulkUpdate(objects, colliders, handles);
+			}
+			AddResult("QuadTree bulk build" + clustering, entityCount, GetElapsedMilliseconds(startTicks) / _iterations);
+
+			std::vector<std::shared_ptr<unsigned int>> objectsFound;
+			startTicks = SDL_GetPerformanceCounter();
+			for (unsigned int j = 0; j < colliders.size(); j++) {
+				quadTree.Query(colliders[j], objectsFound);
+				objectsFoundSink = objectsFoundSink + objectsFound.size();
+			}
+			AddResult("QuadTree bulk query all" + clustering, entityCount, GetElapsedMilliseconds(startTicks));
+			AddResult("QuadTree bulk nodes" + clustering, entityCount, quadTree.GetNodeCount(), "nodes");
+			AddResult("QuadTree bulk straddlers" + clustering, entityCount, quadTree.GetStraddlerCount(), "objects");
+
+			const unsigned int nodeCount = quadTree.GetNodeCount();
+			const unsigned int straddlerCount = quadTree.GetStraddlerCount();
+			std::vector<unsigned int> order(entityCount);
+			for (unsigned int j = 0; j < entityCount; j++) {
+				order[j] = j;
+			}
+			std::shuffle(order.begin(), order.end(), engine);
+			std::vector<Circle> shuffledColliders(entityCount);
+			std::vector<std::shared_ptr<unsigned int>> shuffledObjects(entityCount);
+			for (unsigned int j = 0; j < entityCount; j++) {
+				shuffledColliders[j] = colliders[order[j]];
+				shuffledObjects[j] = objects[order[j]];
+			}
+			quadTree.BulkUpdate(shuffledObjects, shuffledColliders, handles);
+			const bool sameLayout = quadTree.GetNodeCount() == nodeCount && quadTree.GetStraddlerCount() == straddlerCount;
+			AddResult("QuadTree bulk same layout when shuffled" + clustering, entityCount, sameLayout ? 1.0 : 0.0, "bool");
+		}
+	}
+}
+
+/*One frame of projectile collision with as many projectiles as enemies. The quadtrees and the grid find the pairs with one query
+per projectile, the sweep and prune keeps both lists sorted between frames and finds all of them in one sweep*/
+void Benchmark::ProjectilePairBenchmark() {
+	std::mt19937 engine(1234);
+	std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+	//About what the enemies and the projectiles move in one frame at 60 fps
+	const float enemySpeed = 1.f;
+	const float projectileSpeed = 200.f / 60.f;
+	const unsigned int frames = 60;
+	for (unsigned int i = 0; i < _entityCounts.size(); i++) {
+		const unsigned int entityCount = _entityCounts[i];
+		const std::vector<Circle> enemies = CreateColliders(entityCount, engine);
+		std::vector<Circle> projectiles = CreateColliders(entityCount, engine);
+		std::vector<Vector2<float>> enemyVelocities(entityCount);
+		std::vector<Vector2<float>> projectileVelocities(entityCount);
+		for (unsigned int j = 0; j < entityCount; j++) {
+			projectiles[j].radius = 8.f;
+			float direction = angle(engine);
+			enemyVelocities[j] = Vector2<float>(std::cos(direction), std::sin(direction)) * enemySpeed;
+			direction = angle(engine);
+			projectileVelocities[j] = Vector2<float>(std::cos(direction), std::sin(direction)) * projectileSpeed;
+		}
+		std::vector<std::shared_ptr<unsigned int>> objects = CreateObjects(entityCount);
+		unsigned int pairsFound = 0;
+
+		QuadTree<std::shared_ptr<unsigned int>> quadTree(WindowBoundary(), 10);
+		AddResult("QuadTree projectile pairs frame", entityCount,
+			MeasureProjectileFrames(quadTree, enemies, projectiles, enemyVelocities, projectileVelocities, objects, frames, pairsFound));
+		AddResult("QuadTree projectile pairs found", entityCount, pairsFound, "pairs");
+
+		LooseQuadTree<std::shared_ptr<unsigned int>> looseQuadTree(WindowBoundary(), 5);
+		AddResult("LooseQuadTree projectile pairs frame", entityCount,
+			MeasureProjectileFrames(looseQuadTree, enemies, projectiles, enemyVelocities, projectileVelocities, objects, frames, pairsFound));
+		AddResult("LooseQuadTree projectile pairs found", entityCount, pairsFound, "pairs");
+
+		SpatialHashGrid<std::shared_ptr<unsigned int>> spatialHashGrid(WindowBoundary().rectangle, 32.f);
+		AddResult("SpatialHashGrid projectile pairs frame", entityCount,
+			MeasureProjectileFrames(spatialHashGrid, enemies, projectiles, enemyVelocities, projectileVelocities, objects, frames, pairsFound));
+		AddResult("SpatialHashGrid projectile pairs found", entityCount, pairsFound, "pairs");
+
+		SweepAndPrune<std::shared_ptr<unsigned int>> sweepAndPrune;
+		AddResult("SweepAndPrune projectile pairs frame", entityCount,
+			MeasureProjectileFrames(sweepAndPrune, enemies, projectiles, enemyVelocities, projectileVelocities, objects, frames, pairsFound));
+		AddResult("SweepAndPrune projectile pairs found", entityCount, pairsFound, "pairs");
+		AddResult("SweepAndPrune sort moves last frame", entityCount, sweepAndPrune.GetLastFrameSortMoves(), "moves");
+	}
+}
+
+/*Enemies walking at the human speed, turning a little every frame and turning around at the edges of the window. Every enemy needs the enemies overlapping its collider,
+either from a query every frame or from a neighbor list that is filtered down to the overlapping ones.
+The exact query result is used to count the overlaps the neighbor lists missed*/
+void Benchmark::NeighborListBenchmark() {
+	std::mt19937 engine(1234);
+	std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+	std::uniform_real_distribution<float> turn(-0.1f, 0.1f);
+	const float enemySpeed = 75.f / 60.f;
+	const unsigned int frames = 120;
+	const std::vector<float> skins = { 8.f, 16.f, 24.f };
+	for (unsigned int i = 0; i < _entityCounts.size(); i++) {
+		const unsigned int entityCount = _entityCounts[i];
+		std::vector<Circle> colliders = CreateColliders(entityCount, engine);
+		std::vector<float> directions(entityCount);
+		for (unsigned int j = 0; j < entityCount; j++) {
+			directions[j] = angle(engine);
+		}
+		std::vector<std::shared_ptr<unsigned int>> objects = CreateObjects(entityCount);
+		std::vector<int> handles(entityCount, -1);
+		LooseQuadTree<std::shared_ptr<unsigned int>> looseQuadTree(WindowBoundary(), 5);
+
+		std::vector<std::vector<NeighborList<std::shared_ptr<unsigned int>>>> neighborLists(skins.size());
+		for (unsigned int s = 0; s < skins.size(); s++) {
+			neighborLists[s].resize(entityCount, NeighborList<std::shared_ptr<unsigned int>>(skins[s]));
+		}
+		std::vector<Uint64> neighborListTicks(skins.size(), 0);
+		std::vector<unsigned int> neighborListQueries(skins.size(), 0);
+		std::vector<unsigned int> neighborListMisses(skins.size(), 0);
+		unsigned int overlaps = 0;
+		Uint64 queryTicks = 0;
+
+		std::vector<std::shared_ptr<unsigned int>> objectsFound;
+		std::vector<std::shared_ptr<unsigned int>> neighborsFound;
+		for (unsigned int frame = 0; frame < frames; frame++) {
+			for (unsigned int j = 0; j < entityCount; j++) {
+				directions[j] += turn(engine);
+				colliders[j].position += Vector2<float>(std::cos(directions[j]), std::sin(directions[j])) * enemySpeed;
+				if (colliders[j].position.x < 0.f || colliders[j].position.x > windowWidth ||
+					colliders[j].position.y < 0.f || colliders[j].position.y > windowHeight) {
+					directions[j] = std::atan2(windowHeight * 0.5f - colliders[j].position.y, windowWidth * 0.5f - colliders[j].position.x);
+				}
+			}
+			looseQuadTree.BulkUpdate(objects, colliders, handles);
+
+			for (unsigned int j = 0; j < entityCount; j++) {
+				Uint64 startTicks = SDL_GetPerformanceCounter();
+				looseQuadTree.Query(colliders[j], objectsFound);
+				queryTicks += SDL_GetPerformanceCounter() - startTicks;
+				overlaps += objectsFound.size();
+
+				for (unsigned int s = 0; s < skins.size(); s++) {
+					startTicks = SDL_GetPerformanceCounter();
+					if (neighborLists[s][j].Update(colliders[j], enemySpeed, [&looseQuadTree](const Circle& range, std::vector<std::shared_ptr<unsigned int>>& found) {
+						looseQuadTree.Query(range, found);
+					})) {
+						neighborListQueries[s]++;
+					}
+					const std::vector<std::shared_ptr<unsigned int>>& neighbors = neighborLists[s][j].GetObjects();
+					neighborsFound.clear();
+					for (unsigned int k = 0; k < neighbors.size(); k++) {
+						if (CircleIntersect(colliders[j], colliders[*neighbors[k]])) {
+							neighborsFound.emplace_back(neighbors[k]);
+						}
+					}
+					neighborListTicks[s] += SDL_GetPerformanceCounter() - startTicks;
+					//Everything the filter keeps is also in the exact result, so the difference is what the list missed
+					neighborListMisses[s] += objectsFound.size() - neighborsFound.size();
+				}
+			}
+		}
+		const double frequency = (double)SDL_GetPerformanceFrequency();
+		AddResult("Neighbors from a query every frame", entityCount, (double)queryTicks * 1000.0 / frequency / frames);
+		AddResult("Neighbor overlaps found by the queries", entityCount, overlaps, "overlaps");
+		for (unsigned int s = 0; s < skins.size(); s++) {
+			const std::string skin = ", skin " + std::to_string((int)skins[s]);
+			AddResult("Neighbors from neighbor lists" + skin, entityCount, (double)neighborListTicks[s] * 1000.0 / frequency / frames);
+			AddResult("Neighbor list queries per frame" + skin, entityCount, (double)neighborListQueries[s] / frames, "queries");
+			AddResult("Neighbor list missed overlaps" + skin, entityCount, neighborListMisses[s], "overlaps");
+		}
+	}
+}
+
+/*Kills a random active object and spawns a new one straight after, so the number of active objects stays the same.
+The sorted removal gets very slow with many objects, since the active objects are almost sorted already and the quicksort always picks the first one as its pivot,
+so it is only run for a few kills. Stale handles are also tried on the object pool, to check that none of them removes anything*/
+void Benchmark::ObjectPoolBenchmark() {
+	std::mt19937 engine(1234);
+	const unsigned int poolKills = 200000;
+	const unsigned int sortedKills = 20;
+	for (unsigned int i = 0; i < _entityCounts.size(); i++) {
+		const unsigned int entityCount = _entityCounts[i];
+		std::uniform_int_distribution<unsigned int> pick(0, entityCount - 1);
+
+		SortedRemoval sortedRemoval;
+		ObjectPool<std::shared_ptr<PooledObject>> objectPool(entityCount);
+		for (unsigned int j = 0; j < entityCount; j++) {
+			std::shared_ptr<PooledObject> object = std::make_shared<PooledObject>();
+			object->objectID = j;
+			sortedRemoval.activeObjects.emplace_back(object);
+
+			object = std::make_shared<PooledObject>();
+			object->objectID = j;
+			objectPool.PoolObject(object);
+			PoolHandle poolHandle = objectPool.SpawnObject();
+			objectPool.GetObject(poolHandle)->poolHandle = poolHandle;
+		}
+
+		Uint64 startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int kill = 0; kill < sortedKills; kill++) {
+			sortedRemoval.Remove(sortedRemoval.activeObjects[pick(engine)]->objectID);
+			sortedRemoval.activeObjects.emplace_back(sortedRemoval.pooledObjects.back());
+			sortedRemoval.pooledObjects.pop_back();
+		}
+		const double sortedMilliseconds = GetElapsedMilliseconds(startTicks);
+
+		std::vector<PoolHandle> staleHandles;
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int kill = 0; kill < poolKills; kill++) {
+			const PoolHandle poolHandle = objectPool.GetActiveObjects()[pick(engine)]->poolHandle;
+			objectPool.DespawnObject(poolHandle);
+			if (kill % 1000 == 0) {
+				staleHandles.emplace_back(poolHandle);
+			}
+			const PoolHandle spawnedHandle = objectPool.SpawnObject();
+			objectPool.GetObject(spawnedHandle)->poolHandle = spawnedHandle;
+		}
+		const double poolMilliseconds = GetElapsedMilliseconds(startTicks);
+
+		unsigned int staleRemovals = 0;
+		for (unsigned int j = 0; j < staleHandles.size(); j++) {
+			if (objectPool.DespawnObject(staleHandles[j])) {
+				staleRemovals++;
+			}
+		}
+		AddResult("Kills per second with quicksort and binary search", entityCount, sortedKills * 1000.0 / sortedMilliseconds, "kills/s");
+		AddResult("Kills per second with the object pool handles", entityCount, poolKills * 1000.0 / poolMilliseconds, "kills/s");
+		AddResult("Stale handles that removed an object", entityCount, staleRemovals, "removals");
+	}
+}
+
+/*The same objects made one at a time with make_shared, with other allocations of different sizes in between like in the game,
+and made in a slab pool. The order they are updated in is shuffled the same way for both, like the swap and pop removals in the object pools do over time*/
+void Benchmark::SlabPoolBenchmark() {
+	std::mt19937 engine(1234);
+	std::uniform_int_distribution<unsigned int> otherAllocationSize(16, 512);
+	const unsigned int frames = 200;
+	for (unsigned int i = 0; i < _entityCounts.size(); i++) {
+		const unsigned int entityCount = _entityCounts[i];
+		std::vector<Circle> colliders = CreateColliders(entityCount, engine);
+		std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+
+		std::vector<std::shared_ptr<MovingObject>> heapObjects;
+		std::vector<std::shared_ptr<MovingObject>> slabObjects;
+		std::vector<std::vector<char>> otherAllocations;
+		SlabPool<MovingObject> slabPool(256);
+		for (unsigned int j = 0; j < entityCount; j++) {
+			heapObjects.emplace_back(std::make_shared<MovingObject>());
+			heapObjects.back()->collider = colliders[j];
+			const float direction = angle(engine);
+			heapObjects.back()->velocity = Vector2<float>(std::cos(direction), std::sin(direction));
+			otherAllocations.emplace_back(otherAllocationSize(engine));
+
+			slabObjects.emplace_back(slabPool.MakeShared());
+			slabObjects.back()->collider = colliders[j];
+			slabObjects.back()->velocity = heapObjects.back()->velocity;
+		}
+		std::vector<unsigned int> order(entityCount);
+		for (unsigned int j = 0; j < entityCount; j++) {
+			order[j] = j;
+		}
+		//Only a part of them gets moved, the pools swap just a few objects around every frame
+		for (unsigned int j = 0; j < entityCount / 10; j++) {
+			std::swap(order[engine() % entityCount], order[engine() % entityCount]);
+		}
+		std::vector<std::shared_ptr<MovingObject>> heapOrder;
+		std::vector<std::shared_ptr<MovingObject>> slabOrder;
+		for (unsigned int j = 0; j < entityCount; j++) {
+			heapOrder.emplace_back(heapObjects[order[j]]);
+			slabOrder.emplace_back(slabObjects[order[j]]);
+		}
+		AddResult("Update loop over objects made with make_shared", entityCount, MeasureMovingObjects(heapOrder, frames));
+		AddResult("Update loop over objects made in a slab pool", entityCount, MeasureMovingObjects(slabOrder, frames));
+	}
+}
+
+/*Loads a sprite for every object the way the pools used to fill up at startup, with a texture of their own each, and then through the texture cache.
+The texture memory is counted as four bytes a pixel for every texture that is alive once everything has been loaded*/
+void Benchmark::TextureCacheBenchmark() {
+	const std::vector<const char*> spritePaths = { "res/sprites/Fireball.png", "res/sprites/Arcaneball.png", "res/sprites/Human.png",
+		"res/sprites/MadBoar.png", "res/sprites/Staff.png" };
+	for (unsigned int i = 0; i < _entityCounts.size(); i++) {
+		const unsigned int entityCount = _entityCounts[i];
+		std::vector<std::shared_ptr<Sprite>> sprites;
+		unsigned int textureBytes = 0;
+		Uint64 startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int j = 0; j < entityCount; j++) {
+			sprites.emplace_back(std::make_shared<Sprite>());
+			sprites.back()->Load(spritePaths[j % spritePaths.size()]);
+		}
+		const double loadMilliseconds = GetElapsedMilliseconds(startTicks);
+		for (unsigned int j = 0; j < sprites.size(); j++) {
+			textureBytes += sprites[j]->w * sprites[j]->h * 4;
+			SDL_DestroyTexture(sprites[j]->texture);
+		}
+		sprites.clear();
+
+		TextureCache cache;
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int j = 0; j < entityCount; j++) {
+			sprites.emplace_back(cache.GetSprite(spritePaths[j % spritePaths.size()]));
+		}
+		const double cacheMilliseconds = GetElapsedMilliseconds(startTicks);
+
+		AddResult("Loading a texture for every sprite", entityCount, loadMilliseconds);
+		AddResult("Loading sprites through the texture cache", entityCount, cacheMilliseconds);
+		AddResult("Texture memory with a texture for every sprite", entityCount, textureBytes / (1024.0 * 1024.0), "MB");
+		AddResult("Texture memory with the texture cache", entityCount, cache.GetTextureBytes() / (1024.0 * 1024.0), "MB");
+		AddResult("Textures loaded by the texture cache", entityCount, cache.GetLoadCount(), "textures");
+	}
+}
+
+/*Draws fireballs and human enemies at random orientations with the software renderer, the way the game draws without a GPU.
+Once with one SDL_RenderCopyEx for every sprite, and once through the sprite batcher*/
+void Benchmark::SpriteBatchBenchmark() {
+	SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, (int)windowWidth, (int)windowHeight, 32, SDL_PIXELFORMAT_RGBA8888);
+	SDL_Renderer* softwareRenderer = SDL_CreateSoftwareRenderer(target);
+	const std::vector<const char*> spritePaths = { "res/sprites/Fireball.png", "res/sprites/Human.png" };
+	std::vector<SDL_Texture*> textures;
+	std::vector<SDL_Point> textureSizes;
+	for (unsigned int i = 0; i < spritePaths.size(); i++) {
+		SDL_Surface* surface = IMG_Load(spritePaths[i]);
+		textures.emplace_back(SDL_CreateTextureFromSurface(softwareRenderer, surface));
+		textureSizes.push_back({ surface->w, surface->h });
+		SDL_FreeSurface(surface);
+	}
+	SpriteBatcher spriteBatcher(softwareRenderer);
+	std::mt19937 engine(1234);
+	std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+	const unsigned int frames = 10;
+	for (unsigned int i = 0; i < _entityCounts.size(); i++) {
+		const unsigned int entityCount = _entityCounts[i];
+		std::vector<Circle> colliders = CreateColliders(entityCount, engine);
+		std::vector<float> orientations(entityCount);
+		for (unsigned int j = 0; j < entityCount; j++) {
+			orientations[j] = angle(engine);
+		}
+
+		Uint64 startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int frame = 0; frame < frames; frame++) {
+			SDL_RenderClear(softwareRenderer);
+			for (unsigned int j = 0; j < entityCount; j++) {
+				const SDL_Point size = textureSizes[j % textures.size()];
+				SDL_Rect destination = { (int)colliders[j].position.x - size.x / 2, (int)colliders[j].position.y - size.y / 2, size.x, size.y };
+				SDL_RenderCopyEx(softwareRenderer, textures[j % textures.size()], NULL, &destination, orientations[j] * 180 / PI, NULL, SDL_FLIP_NONE);
+			}
+			SDL_RenderPresent(softwareRenderer);
+		}
+		AddResult("Sprites drawn with SDL_RenderCopyEx", entityCount, GetElapsedMilliseconds(startTicks) / frames);
+
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int frame = 0; frame < frames; frame++) {
+			SDL_RenderClear(softwareRenderer);
+			spriteBatcher.Begin();
+			for (unsigned int j = 0; j < entityCount; j++) {
+				const SDL_Point size = textureSizes[j % textures.size()];
+				SDL_FRect destination = { colliders[j].position.x - size.x * 0.5f, colliders[j].position.y - size.y * 0.5f, (float)size.x, (float)size.y };
+				spriteBatcher.Draw(textures[j % textures.size()], size.x, size.y, { 0, 0, size.x, size.y }, destination, orientations[j]);
+			}
+			spriteBatcher.End();
+			SDL_RenderPresent(softwareRenderer);
+		}
+		AddResult("Sprites drawn with the sprite batcher", entityCount, GetElapsedMilliseconds(startTicks) / frames);
+		AddResult("Sprite batcher draw calls", entityCount, spriteBatcher.GetLastDrawCalls(), "calls");
+	}
+	for (unsigned int i = 0; i < textures.size(); i++) {
+		SDL_DestroyTexture(textures[i]);
+	}
+	SDL_DestroyRenderer(softwareRenderer);
+	SDL_FreeSurface(target);
+}
+
+//Rotating every sprite with SDL_RenderCopyEx against copying the closest of 64 pre-rotated angles, both with the software renderer
+void Benchmark::PreRotatedSpriteBenchmark() {
+	SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, (int)windowWidth, (int)windowHeight, 32, SDL_PIXELFORMAT_RGBA8888);
+	SDL_Renderer* softwareRenderer = SDL_CreateSoftwareRenderer(target);
+	const std::vector<const char*> spritePaths = { "res/sprites/Fireball.png", "res/sprites/Human.png" };
+	const int angleCount = 64;
+	std::vector<SDL_Texture*> textures;
+	std::vector<SDL_Point> textureSizes;
+	std::vector<RotatedSprite> rotatedSprites(spritePaths.size());
+	Uint64 startTicks = SDL_GetPerformanceCounter();
+	for (unsigned int i = 0; i < spritePaths.size(); i++) {
+		SDL_Surface* surface = IMG_Load(spritePaths[i]);
+		textures.emplace_back(SDL_CreateTextureFromSurface(softwareRenderer, surface));
+		SDL_SetTextureBlendMode(textures.back(), SDL_BLENDMODE_BLEND);
+		textureSizes.push_back({ surface->w, surface->h });
+		SDL_FreeSurface(surface);
+		rotatedSprites[i].Build(softwareRenderer, textures[i], { 0, 0, textureSizes[i].x, textureSizes[i].y }, 1, angleCount);
+	}
+	AddResult("Pre-rotating the sprites at 64 angles", spritePaths.size(), GetElapsedMilliseconds(startTicks));
+	unsigned int rotatedBytes = 0;
+	for (unsigned int i = 0; i < rotatedSprites.size(); i++) {
+		rotatedBytes += rotatedSprites[i].textureWidth * rotatedSprites[i].textureHeight * 4;
+	}
+	AddResult("Pre-rotated texture memory", spritePaths.size(), rotatedBytes / 1024.0, "KB");
+
+	std::mt19937 engine(1234);
+	std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+	const unsigned int frames = 10;
+	for (unsigned int i = 0; i < _entityCounts.size(); i++) {
+		const unsigned int entityCount = _entityCounts[i];
+		std::vector<Circle> colliders = CreateColliders(entityCount, engine);
+		std::vector<float> orientations(entityCount);
+		for (unsigned int j = 0; j < entityCount; j++) {
+			orientations[j] = angle(engine);
+		}
+
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int frame = 0; frame < frames; frame++) {
+			SDL_RenderClear(softwareRenderer);
+			for (unsigned int j = 0; j < entityCount; j++) {
+				const SDL_Point size = textureSizes[j % textures.size()];
+				SDL_Rect destination = { (int)colliders[j].position.x - size.x / 2, (int)colliders[j].position.y - size.y / 2, size.x, size.y };
+				SDL_RenderCopyEx(softwareRenderer, textures[j % textures.size()], NULL, &destination, orientations[j] * 180 / PI, NULL, SDL_FLIP_NONE);
+			}
+			SDL_RenderPresent(softwareRenderer);
+		}
+		AddResult("Sprites rotated with SDL_RenderCopyEx", entityCount, GetElapsedMilliseconds(startTicks) / frames);
+
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int frame = 0; frame < frames; frame++) {
+			SDL_RenderClear(softwareRenderer);
+			for (unsigned int j = 0; j < entityCount; j++) {
+				const RotatedSprite& rotatedSprite = rotatedSprites[j % rotatedSprites.size()];
+				SDL_Rect source = rotatedSprite.GetCell(0, orientations[j]);
+				SDL_Rect destination = { (int)colliders[j].position.x - rotatedSprite.cellSize / 2, (int)colliders[j].position.y - rotatedSprite.cellSize / 2,
+					rotatedSprite.cellSize, rotatedSprite.cellSize };
+				SDL_RenderCopy(softwareRenderer, rotatedSprite.texture, &source, &destination);
+			}
+			SDL_RenderPresent(softwareRenderer);
+		}
+		AddResult("Pre-rotated sprites drawn with SDL_RenderCopy", entityCount, GetElapsedMilliseconds(startTicks) / frames);
+	}
+	for (unsigned int i = 0; i < textures.size(); i++) {
+		rotatedSprites[i].Destroy();
+		SDL_DestroyTexture(textures[i]);
+	}
+	SDL_DestroyRenderer(softwareRenderer);
+	SDL_FreeSurface(target);
+}
+
+/*Draws a performance overlay with more and more lines of text with the old imgui_sdl backend and with imgui_impl_sdlrenderer, both with the software renderer.
+The entity count is the number of lines of text. Each backend gets an ImGui context of its own, since they both set the font texture*/
+void Benchmark::ImGuiRenderBenchmark() {
+	SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, (int)windowWidth, (int)windowHeight, 32, SDL_PIXELFORMAT_RGBA8888);
+	SDL_Renderer* softwareRenderer = SDL_CreateSoftwareRenderer(target);
+	ImGuiContext* previousContext = ImGui::GetCurrentContext();
+	const std::vector<unsigned int> lineCounts = { 10, 100, 400 };
+	const char* backendNames[] = { "ImGui overlay drawn with imgui_sdl", "ImGui overlay drawn with imgui_impl_sdlrenderer" };
+	const unsigned int frames = 20;
+	for (unsigned int backend = 0; backend < 2; backend++) {
+		ImGuiContext* context = ImGui::CreateContext();
+		ImGui::SetCurrentContext(context);
+		ImGuiIO& io = ImGui::GetIO();
+		io.DisplaySize = ImVec2(windowWidth, windowHeight);
+		io.DeltaTime = 1.f / 60.f;
+		io.IniFilename = NULL;
+		if (backend == 0) {
+			ImGuiSDL::Initialize(softwareRenderer, (int)windowWidth, (int)windowHeight);
+		} else {
+			ImGui_ImplSDLRenderer_Init(softwareRenderer);
+		}
+		for (unsigned int i = 0; i < lineCounts.size(); i++) {
+			Uint64 startTicks = SDL_GetPerformanceCounter();
+			for (unsigned int frame = 0; frame < frames; frame++) {
+				if (backend == 1) {
+					ImGui_ImplSDLRenderer_NewFrame();
+				}
+				ImGui::NewFrame();
+				ImGui::SetNextWindowSize(ImVec2(windowWidth * 0.5f, windowHeight));
+				ImGui::Begin("Performance");
+				//The numbers change every frame like they do in the overlay, so the text is never the same
+				for (unsigned int line = 0; line < lineCounts[i]; line++) {
+					ImGui::Text("Line %u: %.3f ms", line, (frame * lineCounts[i] + line) * 0.001f);
+				}
+				ImGui::End();
+				ImGui::Render();
+				SDL_RenderClear(softwareRenderer);
+				if (backend == 0) {
+					ImGuiSDL::Render(ImGui::GetDrawData());
+				} else {
+					ImGui_ImplSDLRenderer_RenderDrawData(ImGui::GetDrawData());
+				}
+				SDL_RenderPresent(softwareRenderer);
+			}
+			AddResult(backendNames[backend], lineCounts[i], GetElapsedMilliseconds(startTicks) / frames);
+		}
+		if (backend == 0) {
+			ImGuiSDL::Deinitialize();
+		} else {
+			ImGui_ImplSDLRenderer_Shutdown();
+		}
+		ImGui::DestroyContext(context);
+	}
+	ImGui::SetCurrentContext(previousContext);
+	SDL_DestroyRenderer(softwareRenderer);
+	SDL_FreeSurface(target);
+}
+
+/*Steers a crowd of boars and humans heading for the middle of the screen once through their PrioritySteering each, the way the enemies do it,
+and once with the SteeringEngine, including copying the enemies into it. Both get the same neighbors, the enemies get theirs from the
+quadtree beforehand, the way their neighbor lists have them ready, while the engine sorts them into its grid every time.
+The largest difference between the two is written too, to show they steer the same way*/
+void Benchmark::SteeringBenchmark() {
+	std::mt19937 engine(1234);
+	const Vector2<float> target(windowWidth * 0.5f, windowHeight * 0.5f);
+	for (unsigned int i = 0; i < _entityCounts.size(); i++) {
+		const unsigned int entityCount = _entityCounts[i];
+		std::vector<std::shared_ptr<SteeringEnemy>> enemies = CreateSteeringCrowd(entityCount, target, engine);
+
+		SteeringEngine steeringEngine;
+		steeringEngine.SetArchetype(EnemyType::Boar, BoarArchetype());
+		steeringEngine.SetArchetype(EnemyType::Human, HumanArchetype());
+		steeringEngine.Reserve(entityCount);
+
+		//Compared before anything is timed, since ArriveBehavior stops the enemies that have arrived
+		for (unsigned int j = 0; j < entityCount; j++) {
+			steeringEngine.AddAgent(enemies[j]->GetEnemyType(), enemies[j]->GetPosition(), enemies[j]->GetVelocity(),
+				enemies[j]->GetOrientation(), enemies[j]->GetRotation(), target);
+		}
+		steeringEngine.Steer();
+		float largestDifference = 0.f;
+		for (unsigned int j = 0; j < entityCount; j++) {
+			const SteeringOutput steeringOutput = enemies[j]->Steer();
+			const float difference = (steeringOutput.linearVelocity - steeringEngine.GetSteeringOutput(j).linearVelocity).absolute() +
+				fabsf(steeringOutput.angularVelocity - steeringEngine.GetSteeringOutput(j).angularVelocity);
+			largestDifference = difference > largestDifference ? difference : largestDifference;
+		}
+
+		float outputSum = 0.f;
+		Uint64 startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int k = 0; k < _iterations; k++) {
+			for (unsigned int j = 0; j < entityCount; j++) {
+				outputSum += enemies[j]->Steer().angularVelocity;
+			}
+		}
+		const double prioritySteeringMilliseconds = GetElapsedMilliseconds(startTicks);
+
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int k = 0; k < _iterations; k++) {
+			steeringEngine.Clear();
+			for (unsigned int j = 0; j < entityCount; j++) {
+				steeringEngine.AddAgent(enemies[j]->GetEnemyType(), enemies[j]->GetPosition(), enemies[j]->GetVelocity(),
+					enemies[j]->GetOrientation(), enemies[j]->GetRotation(), target);
+			}
+			steeringEngine.Steer();
+			outputSum += steeringEngine.GetSteeringOutput(k % entityCount).angularVelocity;
+		}
+		const double steeringEngineMilliseconds = GetElapsedMilliseconds(startTicks);
+		objectsFoundSink = objectsFoundSink + (size_t)outputSum;
+
+		const double steered = (double)entityCount * _iterations;
+		AddResult("Enemies steered through PrioritySteering", entityCount, steered / prioritySteeringMilliseconds, "enemies/ms");
+		AddResult("Enemies steered by the SteeringEngine", entityCount, steered / steeringEngineMilliseconds, "enemies/ms");
+		AddResult("Largest difference in steering between them", entityCount, largestDifference, "difference");
+	}
+}
+
+/*Runs separation for a crowd of enemies and loops over the walls once for every enemy, the way obstacle avoidance does,
+once through copies like the accessors used to return and once through the references they return now.
+The allocations are counted by the operator new at the top of this file, so they are only written when it's built with COUNT_ALLOCATIONS*/
+void Benchmark::AccessorAllocationBenchmark() {
+	std::mt19937 engine(1234);
+	const Vector2<float> target(windowWidth * 0.5f, windowHeight * 0.5f);
+	ObstacleManager walls;
+	for (unsigned int i = 0; i < 16; i++) {
+		walls.CreateWall(Vector2<float>(windowWidth * (i % 4 + 1) * 0.2f, windowHeight * (i / 4 + 1) * 0.2f), 40.f, 40.f, { 255, 255, 255, 255 });
+	}
+	for (unsigned int i = 0; i < _entityCounts.size(); i++) {
+		const unsigned int entityCount = _entityCounts[i];
+		std::vector<std::shared_ptr<SteeringEnemy>> enemies = CreateSteeringCrowd(entityCount, target, engine);
+		SeparationBehavior separationBehavior;
+		float outputSum = 0.f;
+
+		unsigned long long startAllocations = allocationCount.load();
+		Uint64 startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int k = 0; k < _iterations; k++) {
+			for (unsigned int j = 0; j < entityCount; j++) {
+				outputSum += CopyingSeparation(*enemies[j]).x;
+				for (unsigned int w = 0; w < CopyWalls(walls).size(); w++) {
+					outputSum += CopyWalls(walls)[w]->GetCollider().min.x;
+				}
+			}
+		}
+		const double copyingMilliseconds = GetElapsedMilliseconds(startTicks);
+		const unsigned long long copyingAllocations = allocationCount.load() - startAllocations;
+
+		startAllocations = allocationCount.load();
+		startTicks = SDL_GetPerformanceCounter();
+		for (unsigned int k = 0; k < _iterations; k++) {
+			for (unsigned int j = 0; j < entityCount; j++) {
+				outputSum += separationBehavior.Steering(enemies[j]->GetBehaviorData(), *enemies[j]).linearVelocity.x;
+				const std::vector<std::shared_ptr<Wall>>& wallList = walls.GetWalls();
+				for (unsigned int w = 0; w < wallList.size(); w++) {
+					outputSum += wallList[w]->GetCollider().min.x;
+				}
+			}
+		}
+		const double referenceMilliseconds = GetElapsedMilliseconds(startTicks);
+		const unsigned long long referenceAllocations = allocationCount.load() - startAllocations;
+		objectsFoundSink = objectsFoundSink + (size_t)outputSum;
+
+		AddResult("Separation and walls through copies", entityCount, copyingMilliseconds / _iterations);
+		AddResult("Separation and walls through references", entityCount, referenceMilliseconds / _iterations);
+		if (countingAllocations) {
+			AddResult("Separation and walls through copies", entityCount, (double)copyingAllocations / _iterations, "allocations per frame");
+			AddResult("Separation and walls through references", entityCount, (double)referenceAllocations / _iterations, "allocations per frame");
+		}
+	}
+}
+
+void Benchmark::WriteResults(const char* filePath) {
+	std::ofstream file(filePath);
+	for (unsigned int i = 0; i < _results.size(); i++) {
+		file << _results[i].name << ", " << _results[i].entityCount << " entities, " << _results[i].value << " " << _results[i].unit << "\n";
+	}
+}
+
+void Benchmark::AddResult(std::string name, unsigned int entityCount, double value, std::string unit) {
+	BenchmarkResult result;
+	result.name = name;
+	result.entityCount = entityCount;
+	result.value = value;
+	result.unit = unit;
+	_results.emplace_back(result);
+}
+
+double Benchmark::GetElapsedMilliseconds(Uint64 startTicks) {
+	return (double)(SDL_GetPerformanceCounter() - startTicks) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include <string>
+#include <vector>
+
+struct BenchmarkResult {
+	std::string name;
+	unsigned int entityCount = 0;
+	double value = 0.0;
+	std::string unit = "ms";
+};
+
+/*Runs the performance benchmarks without opening the game.
+Started by passing --benchmark to the executable, the results are written to a text file*/
+class Benchmark {
+public:
+	Benchmark() {}
+	~Benchmark() {}
+
+	void RunAll();
+
+	void QuadTreeBenchmark();
+	void BroadphaseBenchmark();
+	void QuadTreeCapacityBenchmark();
+	void SpatialQueryBenchmark();
+	void QuadTreeBulkBuildBenchmark();
+	void ProjectilePairBenchmark();
+	void NeighborListBenchmark();
+	void ObjectPoolBenchmark();
+	void SlabPoolBenchmark();
+	void TextureCacheBenchmark();
+	void SpriteBatchBenchmark();
+	void PreRotatedSpriteBenchmark();
+	void ImGuiRenderBenchmark();
+	void SteeringBenchmark();
+	void AccessorAllocationBenchmark();
+
+	void WriteResults(const char* filePath);
+
+private:
+	void AddResult(std::string name, unsigned int entityCount, double value, std::string unit = "ms");
+
+	double GetElapsedMilliseconds(Uint64 startTicks);
+
+	std::vector<BenchmarkResult> _results;
+
+	const std::vector<unsigned int> _entityCounts = { 1000, 5000, 10000 };
+	const unsigned int _iterations = 20;
+};
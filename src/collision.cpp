@@ -59,6 +59,64 @@ bool AABBCircleIntersect(AABB& box, Circle& circle) {
 	return (distance < circle.radius);
 }
 
+bool RayCircleIntersect(Ray ray, Circle circle, float& distance) {
+	const Vector2<float> toCircle = circle.position - ray.startPosition;
+	const float projection = Vector2<float>::dotProduct(toCircle, ray.direction);
+	const float distanceToLineSquared = Vector2<float>::dotProduct(toCircle, toCircle) - projection * projection;
+	const float radiusSquared = circle.radius * circle.radius;
+	if (distanceToLineSquared > radiusSquared) {
+		return false;
+	}
+	//The ray hits the circle twice, the first hit is used unless the ray starts inside the circle
+	const float halfChord = sqrt(radiusSquared - distanceToLineSquared);
+	distance = projection - halfChord;
+	if (distance < 0.f) {
+		if (projection + halfChord < 0.f) {
+			return false;
+		}
+		distance = 0.f;
+	}
+	return distance <= ray.length;
+}
+
+bool RayAABBIntersect(Ray ray, AABB& box, float& distance) {
+	float rayEntry = 0.f;
+	float rayExit = ray.length;
+	const float start[2] = { ray.startPosition.x, ray.startPosition.y };
+	const float direction[2] = { ray.direction.x, ray.direction.y };
+	const float boxMin[2] = { box.min.x, box.min.y };
+	const float boxMax[2] = { box.max.x, box.max.y };
+	//Checks the ray against the two slabs between the sides of the box, the ray is inside the box where they overlap
+	for (int i = 0; i < 2; i++) {
+		if (direction[i] == 0.f) {
+			if (start[i] < boxMin[i] || start[i] > boxMax[i]) {
+				return false;
+			}
+			continue;
+		}
+		float slabEntry = (boxMin[i] - start[i]) / direction[i];
+		float slabExit = (boxMax[i] - start[i]) / direction[i];
+		if (slabEntry > slabExit) {
+			const float swap = slabEntry;
+			slabEntry = slabExit;
+			slabExit = swap;
+		}
+		rayEntry = slabEntry > rayEntry ? slabEntry : rayEntry;
+		rayExit = slabExit < rayExit ? slabExit : rayExit;
+		if (rayEntry > rayExit) {
+			return false;
+		}
+	}
+	distance = rayEntry;
+	return true;
+}
+
+float PointAABBDistance(Vector2<float> point, AABB& box) {
+	float deltaX = point.x - Clamp(point.x, box.min.x, box.max.x);
+	float deltaY = point.y - Clamp(point.y, box.min.y, box.max.y);
+	return sqrt(deltaX * deltaX + deltaY * deltaY);
+}
+
 void AABB::SetTargetPosition(Vector2<float> newPosition) {
 	position = newPosition;
 	min.x = position.x - (width * 0.5f);
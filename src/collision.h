@@ -36,4 +36,12 @@ bool CircleIntersect(Circle circleA, Circle circleB);
 
 bool AABBIntersect(AABB& boxA, AABB& boxB);
 
-bool AABBCircleIntersect(AABB& box, Circle& circle);
\ No newline at end of file
+bool AABBCircleIntersect(AABB& box, Circle& circle);
+
+//The direction of the ray has to be normalized, distance is set to how far along the ray the hit is
+bool RayCircleIntersect(Ray ray, Circle circle, float& distance);
+
+//Distance is set to where the ray enters the box, or 0 if the ray starts inside it
+bool RayAABBIntersect(Ray ray, AABB& box, float& distance);
+
+float PointAABBDistance(Vector2<float> point, AABB& box);
\ No newline at end of file
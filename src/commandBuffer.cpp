@@ -0,0 +1 @@
+#include "commandBuffer.h"
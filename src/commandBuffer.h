@@ -0,0 +1,118 @@
+#pragma once
+#include "objectPool.h"
+
+#include <vector>
+
+/*The spawns and despawns that are asked for during a frame are only recorded here, while the managers and everything else are still looping over the active objects.
+The manager applies all of them at once at the end of the frame, when nothing is looping anymore, so no loop has objects swapped around under it.
+Type is the enum used to pick the object pool, and SpawnCommand is whatever the manager needs to spawn an object*/
+template<typename Type, typename SpawnCommand>
+class CommandBuffer {
+public:
+	CommandBuffer() {}
+	~CommandBuffer() {}
+
+	void RecordSpawn(const SpawnCommand& spawnCommand);
+	//Returns false if the object is already going to be despawned
+	bool RecordDespawn(Type type, PoolHandle poolHandle);
+	//Looked up by the slot of the handle, so it doesn't matter how many despawns are recorded
+	bool IsDespawnRecorded(Type type, PoolHandle poolHandle) const;
+
+	const unsigned int GetSpawnCount() const;
+	const unsigned int GetDespawnCount() const;
+
+	/*Calls despawn(type, poolHandle) for every recorded despawn and then spawn(spawnCommand) for every recorded spawn, in the order they were recorded.
+	The despawns go first so the spawns can reuse their objects. Anything recorded while applying is kept for the next time*/
+	template<typename Despawn, typename Spawn>
+	void Apply(Despawn&& despawn, Spawn&& spawn);
+	void Clear();
+
+private:
+	struct DespawnCommand {
+		Type type;
+		PoolHandle poolHandle;
+	};
+
+	std::vector<SpawnCommand> _spawnCommands;
+	std::vector<DespawnCommand> _despawnCommands;
+
+	//Swapped with the recorded commands when they are applied, so the vectors keep their memory between frames
+	std::vector<SpawnCommand> _applyingSpawnCommands;
+	std::vector<DespawnCommand> _applyingDespawnCommands;
+
+	/*For every type and pool slot, the generation of the handle whose despawn is recorded plus one, zero if there's none.
+	Grown as slots show up, so it's only as big as the pools*/
+	std::vector<std::vector<unsigned int>> _recordedDespawns;
+};
+
+template<typename Type, typename SpawnCommand>
+inline void CommandBuffer<Type, SpawnCommand>::RecordSpawn(const SpawnCommand& spawnCommand) {
+	_spawnCommands.emplace_back(spawnCommand);
+}
+
+template<typename Type, typename SpawnCommand>
+inline bool CommandBuffer<Type, SpawnCommand>::RecordDespawn(Type type, PoolHandle poolHandle) {
+	if (IsDespawnRecorded(type, poolHandle)) {
+		return false;
+	}
+	if (poolHandle.slot < 0) {
+		return false;
+	}
+	const unsigned int typeIndex = (unsigned int)type;
+	if (typeIndex >= _recordedDespawns.size()) {
+		_recordedDespawns.resize(typeIndex + 1);
+	}
+	if ((unsigned int)poolHandle.slot >= _recordedDespawns[typeIndex].size()) {
+		_recordedDespawns[typeIndex].resize(poolHandle.slot + 1, 0);
+	}
+	_recordedDespawns[typeIndex][poolHandle.slot] = poolHandle.generation + 1;
+	DespawnCommand despawnCommand;
+	despawnCommand.type = type;
+	despawnCommand.poolHandle = poolHandle;
+	_despawnCommands.emplace_back(despawnCommand);
+	return true;
+}
+
+template<typename Type, typename SpawnCommand>
+inline bool CommandBuffer<Type, SpawnCommand>::IsDespawnRecorded(Type type, PoolHandle poolHandle) const {
+	const unsigned int typeIndex = (unsigned int)type;
+	if (poolHandle.slot < 0 || typeIndex >= _recordedDespawns.size() || (unsigned int)poolHandle.slot >= _recordedDespawns[typeIndex].size()) {
+		return false;
+	}
+	return _recordedDespawns[typeIndex][poolHandle.slot] == poolHandle.generation + 1;
+}
+
+template<typename Type, typename SpawnCommand>
+inline const unsigned int CommandBuffer<Type, SpawnCommand>::GetSpawnCount() const {
+	return _spawnCommands.size();
+}
+
+template<typename Type, typename SpawnCommand>
+inline const unsigned int CommandBuffer<Type, SpawnCommand>::GetDespawnCount() const {
+	return _despawnCommands.size();
+}
+
+template<typename Type, typename SpawnCommand>
+template<typename Despawn, typename Spawn>
+inline void CommandBuffer<Type, SpawnCommand>::Apply(Despawn&& despawn, Spawn&& spawn) {
+	_applyingDespawnCommands.clear();
+	_applyingSpawnCommands.clear();
+	std::swap(_applyingDespawnCommands, _despawnCommands);
+	std::swap(_applyingSpawnCommands, _spawnCommands);
+	for (unsigned int i = 0; i < _applyingDespawnCommands.size(); i++) {
+		_recordedDespawns[(unsigned int)_applyingDespawnCommands[i].type][_applyingDespawnCommands[i].poolHandle.slot] = 0;
+		despawn(_applyingDespawnCommands[i].type, _applyingDespawnCommands[i].poolHandle);
+	}
+	for (unsigned int i = 0; i < _applyingSpawnCommands.size(); i++) {
+		spawn(_applyingSpawnCommands[i]);
+	}
+}
+
+template<typename Type, typename SpawnCommand>
+inline void CommandBuffer<Type, SpawnCommand>::Clear() {
+	for (unsigned int i = 0; i < _despawnCommands.size(); i++) {
+		_recordedDespawns[(unsigned int)_despawnCommands[i].type][_despawnCommands[i].poolHandle.slot] = 0;
+	}
+	_spawnCommands.clear();
+	_despawnCommands.clear();
+}
@@ -1,9 +1,26 @@
 #include "debugDrawer.h"
 #include "gameEngine.h"
+#include "imGuiManager.h"
 
 #include <SDL2/SDL.h>
 
-void DebugDrawer::AddDebugBox(Vector2<float> position, Vector2<float> min, Vector2<float> max, SDL_Color color) {
+#include <cmath>
+
+namespace {
+	const char* channelNames[] = { "Interface", "Formations", "Steering", "Spatial index" };
+}
+
+DebugDrawer::DebugDrawer() {
+	const float step = (2 * PI) / circleSegments;
+	for (int k = 0; k <= circleSegments; k++) {
+		_unitCircle[k] = Vector2<float>(cosf(step * k), sinf(step * k));
+	}
+}
+
+void DebugDrawer::AddDebugBox(DebugChannel channel, Vector2<float> position, Vector2<float> min, Vector2<float> max, SDL_Color color) {
+	if (!IsChannelEnabled(channel)) {
+		return;
+	}
 	DebugBox debugBox;
 	debugBox.min = min;
 	debugBox.max = max;
@@ -12,7 +29,10 @@ void DebugDrawer::AddDebugBox(Vector2<float> position, Vector2<float> min, Vecto
 	_debugBoxes.emplace_back(debugBox);
 }
 
-void DebugDrawer::AddDebugRectangle(Vector2<float> position, Vector2<float> min, Vector2<float> max, SDL_Color color) {
+void DebugDrawer::AddDebugRectangle(DebugChannel channel, Vector2<float> position, Vector2<float> min, Vector2<float> max, SDL_Color color) {
+	if (!IsChannelEnabled(channel)) {
+		return;
+	}
 	DebugBox debugBox;
 	debugBox.min = min;
 	debugBox.max = max;
@@ -21,7 +41,10 @@ void DebugDrawer::AddDebugRectangle(Vector2<float> position, Vector2<float> min,
 	_debugRectangles.emplace_back(debugBox);
 }
 
-void DebugDrawer::AddDebugCircle(Vector2<float> position, float radius, SDL_Color color) {
+void DebugDrawer::AddDebugCircle(DebugChannel channel, Vector2<float> position, float radius, SDL_Color color) {
+	if (!IsChannelEnabled(channel)) {
+		return;
+	}
 	DebugCircle debugCircle;
 	debugCircle.position = position;
 	debugCircle.radius = radius;
@@ -29,7 +52,10 @@ void DebugDrawer::AddDebugCircle(Vector2<float> position, float radius, SDL_Colo
 	_debugCircles.emplace_back(debugCircle);
 }
 
-void DebugDrawer::AddDebugCross(Vector2<float> position, float length, SDL_Color color) {
+void DebugDrawer::AddDebugCross(DebugChannel channel, Vector2<float> position, float length, SDL_Color color) {
+	if (!IsChannelEnabled(channel)) {
+		return;
+	}
 	DebugLine debugLineHorizontal;
 	DebugLine debugLineVertical;
 
@@ -45,7 +71,10 @@ void DebugDrawer::AddDebugCross(Vector2<float> position, float length, SDL_Color
 	_debugLines.emplace_back(debugLineVertical);
 }
 
-void DebugDrawer::AddDebugLine(Vector2<float> startPosition, Vector2<float> endPosition, SDL_Color color) {
+void DebugDrawer::AddDebugLine(DebugChannel channel, Vector2<float> startPosition, Vector2<float> endPosition, SDL_Color color) {
+	if (!IsChannelEnabled(channel)) {
+		return;
+	}
 	DebugLine debugLine;
 	debugLine.startPosition = startPosition;
 	debugLine.endPosition = endPosition;
@@ -53,68 +82,99 @@ void DebugDrawer::AddDebugLine(Vector2<float> startPosition, Vector2<float> endP
 	_debugLines.emplace_back(debugLine);
 }
 
+void DebugDrawer::SetChannelEnabled(DebugChannel channel, bool enabled) {
+	_enabledChannels[(unsigned int)channel] = enabled;
+}
+
+void DebugDrawer::ShowChannels() {
+	for (unsigned int i = 0; i < _enabledChannels.size(); i++) {
+		imGuiHandler->Checkbox("Debug drawing", channelNames[i], _enabledChannels[i]);
+	}
+}
+
 void DebugDrawer::DrawBoxes() {
-	for (int i = 0; i < _debugBoxes.size(); i++) {
-		SDL_SetRenderDrawColor(renderer, _debugBoxes[i].color.r, _debugBoxes[i].color.g, _debugBoxes[i].color.b, _debugBoxes[i].color.a);
-		SDL_Rect rect = {
-			_debugBoxes[i].position.x - ((_debugBoxes[i].max.x - _debugBoxes[i].min.x) * 0.5f),
-			_debugBoxes[i].position.y - ((_debugBoxes[i].max.y - _debugBoxes[i].min.y) * 0.5f),
-			_debugBoxes[i].max.x - _debugBoxes[i].min.x,
-			_debugBoxes[i].max.y - _debugBoxes[i].min.y
-		};
-		SDL_RenderFillRect(renderer, &rect);
+	for (unsigned int i = 0; i < _debugBoxes.size(); i++) {
+		const Vector2<float> halfSize = (_debugBoxes[i].max - _debugBoxes[i].min) * 0.5f;
+		AddQuad(_debugBoxes[i].position - halfSize, _debugBoxes[i].position + halfSize, _debugBoxes[i].color);
 	}
+	DrawGeometry();
 	_debugBoxes.clear();
 }
 
 void DebugDrawer::DrawRectangles() {
-	for (int i = 0; i < _debugRectangles.size(); i++) {
-		SDL_SetRenderDrawColor(renderer, _debugRectangles[i].color.r, _debugRectangles[i].color.g, _debugRectangles[i].color.b, _debugRectangles[i].color.a);
-		SDL_Rect rect = {
-			_debugRectangles[i].position.x - ((_debugRectangles[i].max.x - _debugRectangles[i].min.x) * 0.5f),
-			_debugRectangles[i].position.y - ((_debugRectangles[i].max.y - _debugRectangles[i].min.y) * 0.5f),
-			_debugRectangles[i].max.x - _debugRectangles[i].min.x,
-			_debugRectangles[i].max.y - _debugRectangles[i].min.y			
-		};
-		SDL_RenderDrawRect(renderer, &rect);
+	for (unsigned int i = 0; i < _debugRectangles.size(); i++) {
+		const Vector2<float> halfSize = (_debugRectangles[i].max - _debugRectangles[i].min) * 0.5f;
+		const Vector2<float> min = _debugRectangles[i].position - halfSize;
+		const Vector2<float> max = _debugRectangles[i].position + halfSize;
+		const SDL_Color color = _debugRectangles[i].color;
+		AddLineQuad(min, Vector2<float>(max.x, min.y), color);
+		AddLineQuad(Vector2<float>(max.x, min.y), max, color);
+		AddLineQuad(max, Vector2<float>(min.x, max.y), color);
+		AddLineQuad(Vector2<float>(min.x, max.y), min, color);
 	}
+	DrawGeometry();
 	_debugRectangles.clear();
 }
 
 void DebugDrawer::DrawCircles() {
-	for (int i = 0; i < _debugCircles.size(); i++) {
-		SDL_SetRenderDrawColor(renderer, _debugRectangles[i].color.r, _debugRectangles[i].color.g, _debugRectangles[i].color.b, _debugRectangles[i].color.a);
-
-		int resolution = 24;
-		float step = (2 * PI) / resolution;
-
-		for (int k = 0; k < resolution; k++) {
-
-			float angle = step * k;
-			float x1 = cos(angle);
-			float y1 = sin(angle);
-
-			float nextAngle = step * (k + 1);
-			float x2 = cos(nextAngle);
-			float y2 = sin(nextAngle);
-
-			SDL_RenderDrawLine(
-				renderer,
-				x1 * _debugCircles[i].radius + _debugCircles[i].position.x,
-				y1 * _debugCircles[i].radius + _debugCircles[i].position.y,
-				x2 * _debugCircles[i].radius + _debugCircles[i].position.x,
-				y2 * _debugCircles[i].radius + _debugCircles[i].position.y);
-
+	for (unsigned int i = 0; i < _debugCircles.size(); i++) {
+		const Vector2<float> position = _debugCircles[i].position;
+		const float radius = _debugCircles[i].radius;
+		for (int k = 0; k < circleSegments; k++) {
+			AddLineQuad(_unitCircle[k] * radius + position, _unitCircle[k + 1] * radius + position, _debugCircles[i].color);
 		}
 	}
+	DrawGeometry();
 	_debugCircles.clear();
 }
 
 void DebugDrawer::DrawLines() {
-	for (int i = 0; i < _debugLines.size(); i++) {
-	SDL_SetRenderDrawColor(renderer, _debugLines[i].color.r, _debugLines[i].color.g, _debugLines[i].color.b, _debugLines[i].color.a);
-		SDL_RenderDrawLineF(renderer, _debugLines[i].startPosition.x, _debugLines[i].startPosition.y, 
-			_debugLines[i].endPosition.x, _debugLines[i].endPosition.y);
+	for (unsigned int i = 0; i < _debugLines.size(); i++) {
+		AddLineQuad(_debugLines[i].startPosition, _debugLines[i].endPosition, _debugLines[i].color);
 	}
+	DrawGeometry();
 	_debugLines.clear();
 }
+
+void DebugDrawer::AddQuad(Vector2<float> min, Vector2<float> max, SDL_Color color) {
+	const int firstVertex = (int)_vertices.size();
+	_vertices.push_back({ { min.x, min.y }, color, { 0.f, 0.f } });
+	_vertices.push_back({ { max.x, min.y }, color, { 0.f, 0.f } });
+	_vertices.push_back({ { max.x, max.y }, color, { 0.f, 0.f } });
+	_vertices.push_back({ { min.x, max.y }, color, { 0.f, 0.f } });
+	_indices.push_back(firstVertex);
+	_indices.push_back(firstVertex + 1);
+	_indices.push_back(firstVertex + 2);
+	_indices.push_back(firstVertex);
+	_indices.push_back(firstVertex + 2);
+	_indices.push_back(firstVertex + 3);
+}
+
+//The line is widened by half a pixel on both sides, so it's as wide as one drawn with SDL_RenderDrawLine
+void DebugDrawer::AddLineQuad(Vector2<float> startPosition, Vector2<float> endPosition, SDL_Color color) {
+	const Vector2<float> direction = endPosition - startPosition;
+	const float length = direction.absolute();
+	if (length <= 0.f) {
+		return;
+	}
+	const Vector2<float> side = Vector2<float>(-direction.y, direction.x) * (0.5f / length);
+	const int firstVertex = (int)_vertices.size();
+	_vertices.push_back({ { startPosition.x + side.x, startPosition.y + side.y }, color, { 0.f, 0.f } });
+	_vertices.push_back({ { endPosition.x + side.x, endPosition.y + side.y }, color, { 0.f, 0.f } });
+	_vertices.push_back({ { endPosition.x - side.x, endPosition.y - side.y }, color, { 0.f, 0.f } });
+	_vertices.push_back({ { startPosition.x - side.x, startPosition.y - side.y }, color, { 0.f, 0.f } });
+	_indices.push_back(firstVertex);
+	_indices.push_back(firstVertex + 1);
+	_indices.push_back(firstVertex + 2);
+	_indices.push_back(firstVertex);
+	_indices.push_back(firstVertex + 2);
+	_indices.push_back(firstVertex + 3);
+}
+
+void DebugDrawer::DrawGeometry() {
+	if (!_indices.empty()) {
+		SDL_RenderGeometry(renderer, NULL, _vertices.data(), (int)_vertices.size(), _indices.data(), (int)_indices.size());
+	}
+	_vertices.clear();
+	_indices.clear();
+}
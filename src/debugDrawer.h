@@ -1,10 +1,20 @@
 #pragma once
 #include "SDL2/SDL_pixels.h"
+#include "SDL2/SDL_render.h"
 #include "vector2.h"
 
 #include <array>
 #include <vector>
 
+//What the debug shapes are for, so each kind can be turned on and off while the game is running
+enum class DebugChannel {
+	Interface,
+	Formations,
+	Steering,
+	SpatialIndex,
+	Count
+};
+
 struct DebugBox {
 	Vector2<float> min = Vector2<float>(0.f, 0.f);
 	Vector2<float> max = Vector2<float>(0.f, 0.f);
@@ -23,27 +33,50 @@ struct DebugLine {
 };
 
 
+/*Every kind of shape is drawn with a single SDL_RenderGeometry call, the outlines are made of one pixel wide quads so they can be batched with their colors.
+Shapes added to a channel that is turned off are thrown away straight away. Anything that adds a lot of shapes every frame should check IsChannelEnabled first,
+then it doesn't even have to work out where the shapes would go*/
 class DebugDrawer {
 public:
-	DebugDrawer() {}
+	DebugDrawer();
 	~DebugDrawer() {}
 
-	void AddDebugBox(Vector2<float> position, Vector2<float> min, Vector2<float> max, SDL_Color color);
-	void AddDebugRectangle(Vector2<float> position, Vector2<float> min, Vector2<float> max, SDL_Color color);
-	void AddDebugCircle(Vector2<float> position, float radius, SDL_Color color);
-	void AddDebugCross(Vector2<float> position, float length, SDL_Color color);
-	void AddDebugLine(Vector2<float> startPosition, Vector2<float> endPosition, SDL_Color color);
+	void AddDebugBox(DebugChannel channel, Vector2<float> position, Vector2<float> min, Vector2<float> max, SDL_Color color);
+	void AddDebugRectangle(DebugChannel channel, Vector2<float> position, Vector2<float> min, Vector2<float> max, SDL_Color color);
+	void AddDebugCircle(DebugChannel channel, Vector2<float> position, float radius, SDL_Color color);
+	void AddDebugCross(DebugChannel channel, Vector2<float> position, float length, SDL_Color color);
+	void AddDebugLine(DebugChannel channel, Vector2<float> startPosition, Vector2<float> endPosition, SDL_Color color);
+
+	bool IsChannelEnabled(DebugChannel channel) const { return _enabledChannels[(unsigned int)channel]; }
+	void SetChannelEnabled(DebugChannel channel, bool enabled);
+	//A checkbox for every channel in the Debug drawing window
+	void ShowChannels();
 
 	void DrawBoxes();
 	void DrawRectangles();
 	void DrawCircles();
 	void DrawLines();
 
+	static constexpr int circleSegments = 24;
+
 private:
+	void AddQuad(Vector2<float> min, Vector2<float> max, SDL_Color color);
+	void AddLineQuad(Vector2<float> startPosition, Vector2<float> endPosition, SDL_Color color);
+	//Draws the quads that have been added and clears them
+	void DrawGeometry();
+
 	std::vector<DebugBox> _debugBoxes;
 	std::vector<DebugBox> _debugRectangles;
 	std::vector<DebugLine> _debugLines;
 	std::vector<DebugCircle> _debugCircles;
 
+	//Only the buttons are drawn with debug boxes in normal play, everything else has to be turned on
+	std::array<bool, (unsigned int)DebugChannel::Count> _enabledChannels = { true, false, false, false };
+	//Worked out once, a circle is just these points scaled by the radius and moved to its position
+	std::array<Vector2<float>, circleSegments + 1> _unitCircle;
+
+	//Kept between frames so they don't have to be allocated again
+	std::vector<SDL_Vertex> _vertices;
+	std::vector<int> _indices;
 };
 
@@ -1 +1,53 @@
-#include "enemyBase.h"
\ No newline at end of file
+#include "enemyBase.h"
+
+#include "gameEngine.h"
+#include "layeredSpatialIndex.h"
+
+//Any neighbor could be the fastest enemy that has been spawned, so that's how far they are all counted as having moved
+void EnemyBase::UpdateNeighbors() {
+	_neighborList.Update(_circleCollider, enemyManager->GetFastestEnemySpeed() * deltaTime, [](const Circle& range, std::vector<std::shared_ptr<ObjectBase>>& objectsFound) {
+		objectBaseQuadTree->Query(range, LayerBit(CollisionLayer::Enemy), objectsFound);
+	});
+	//Everything in the enemy layer is an enemy, and the list keeps them alive, so a plain cast is enough here
+	const std::vector<std::shared_ptr<ObjectBase>>& neighbors = _neighborList.GetObjects();
+	_queriedObjects.clear();
+	for (unsigned int i = 0; i < neighbors.size(); i++) {
+		if (CircleIntersect(_circleCollider, static_cast<EnemyBase*>(neighbors[i].get())->GetCollider())) {
+			_queriedObjects.emplace_back(neighbors[i]);
+		}
+	}
+}
+
+const float EnemyBase::GetTopSpeed() const {
+	return _behaviorData.maxSpeed;
+}
+
+void EnemyBase::InvalidateNeighbors() {
+	_neighborList.Invalidate();
+}
+
+const float EnemyBase::GetNeighborSkin() const {
+	return _neighborList.GetSkin();
+}
+
+const SteeringArchetype EnemyBase::GetSteeringArchetype() const {
+	SteeringArchetype steeringArchetype;
+	steeringArchetype.behaviorData = _behaviorData;
+	steeringArchetype.separationFirst = _separationFirst;
+	return steeringArchetype;
+}
+
+bool EnemyBase::TakeBatchSteering() {
+	const bool batchSteered = _batchSteered;
+	_batchSteered = false;
+	if (batchSteered) {
+		_neighborList.Invalidate();
+	}
+	return batchSteered;
+}
+
+void EnemyBase::SetSteeringOutput(SteeringOutput steeringOutput, bool stopped) {
+	_steeringOutput = steeringOutput;
+	_batchSteered = true;
+	_batchStopped = stopped;
+}
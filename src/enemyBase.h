@@ -2,9 +2,11 @@
 #include "collision.h"
 #include "enemyManager.h"
 #include "formationManager.h"
+#include "neighborList.h"
 #include "objectBase.h"
 #include "sprite.h"
 #include "steeringBehavior.h"
+#include "steeringEngine.h"
 #include "vector2.h"
 
 class Timer;
@@ -36,11 +38,14 @@ public:
 
 	virtual const int GetCurrentHealth() const = 0;
 
-	virtual const BehaviorData GetBehaviorData() const = 0;
+	virtual const BehaviorData& GetBehaviorData() const = 0;
 	
 	virtual const Vector2<float> GetVelocity() const = 0;
+	//The fastest the enemy can ever move, the neighbor lists of all the enemies are kept up to date with the fastest of them
+	virtual const float GetTopSpeed() const;
 
-	virtual const std::vector<std::shared_ptr<ObjectBase>> GetQueriedObjects() const = 0;
+	//The enemies overlapping this one since the last UpdateNeighbors, including itself
+	virtual const std::vector<std::shared_ptr<ObjectBase>>& GetQueriedObjects() const = 0;
 
 	virtual const std::shared_ptr<WeaponComponent> GetWeaponComponent() const = 0;
 	
@@ -53,11 +58,32 @@ public:
 	virtual void SetTargetOrientation(float targetOrientation) = 0;
 	virtual void SetVelocity(Vector2<float> velocity) = 0;
 
+	//The parameters and steering groups every enemy of this type has, for the SteeringEngine
+	const SteeringArchetype GetSteeringArchetype() const;
+	//Used instead of the PrioritySteering the next time the enemy moves, stopped is true if it arrived and should stand still
+	void SetSteeringOutput(SteeringOutput steeringOutput, bool stopped);
+
+	//The next UpdateNeighbors queries again, used when an enemy spawns close enough that the cached list could be missing it
+	void InvalidateNeighbors();
+	const float GetNeighborSkin() const;
+
 protected:
+	/*Keeps the neighbor list up to date and fills _queriedObjects with the enemies in it that overlap the collider right now.
+	That's the same list a query with the collider would give, without querying the index every frame*/
+	void UpdateNeighbors();
+	/*Returns true if the EnemyManager steered the enemy this frame and clears it, so it has to be called at the start of every Update.
+	Then the SteeringEngine has found the neighbors itself and the neighbor list is only marked out of date instead of being updated*/
+	bool TakeBatchSteering();
+
 	BehaviorData _behaviorData;
 	SteeringOutput _steeringOutput;
 	std::shared_ptr<BlendSteering> _blendSteering = nullptr;
 	std::shared_ptr<PrioritySteering> _prioritySteering = nullptr;
+	//True if the separation group comes before the others in the PrioritySteering, instead of everything being in one blend
+	bool _separationFirst = false;
+	//Set when the EnemyManager already steered the enemy this frame, cleared by TakeBatchSteering
+	bool _batchSteered = false;
+	bool _batchStopped = false;
 	std::shared_ptr<WeaponComponent> _weaponComponent = nullptr;
 
 	Circle _circleCollider;
@@ -73,5 +99,6 @@ protected:
 	Vector2<float> _velocity = Vector2<float>(0.f, 0.f);
 
 	std::vector<std::shared_ptr<ObjectBase>> _queriedObjects;
+	NeighborList<std::shared_ptr<ObjectBase>> _neighborList;
 };
 
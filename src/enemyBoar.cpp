@@ -4,17 +4,18 @@
 #include "debugDrawer.h"
 #include "gameEngine.h"
 #include "imGuiManager.h"
+#include "layeredSpatialIndex.h"
 #include "playerCharacter.h"
 #include "quadTree.h"
 #include "steeringBehavior.h"
+#include "textureCache.h"
 #include "timerManager.h"
 
 #include <memory>
 
 EnemyBoar::EnemyBoar(unsigned int objectID, EnemyType enemyType) :
 	EnemyBase(objectID, enemyType) {
-	_sprite = std::make_shared<Sprite>();
-	_sprite->Load(_boarSprite);
+	_sprite = textureCache->GetSprite(_boarSprite);
 
 	_position = Vector2<float>(-10000.f, -10000.f);
 
@@ -49,6 +50,7 @@ EnemyBoar::EnemyBoar(unsigned int objectID, EnemyType enemyType) :
 	_blendSteering->ClearBehaviours();
 	_blendSteering->AddSteeringBehaviour(BehaviorAndWeight(std::make_shared<SeparationBehavior>(), 1.f));
 	_prioritySteering->AddGroup(*_blendSteering);
+	_separationFirst = true;
 
 	_blendSteering->ClearBehaviours();
 	_blendSteering->AddSteeringBehaviour(BehaviorAndWeight(std::make_shared<ArriveBehavior>(), 1.f));
@@ -68,10 +70,14 @@ void EnemyBoar::Init() {
 }
 
 void EnemyBoar::Update() {
-	_queriedObjects = objectBaseQuadTree->Query(_circleCollider);
+	//Taken even while dashing, so the steering of this frame isn't used in a later one
+	const bool batchSteered = TakeBatchSteering();
+	if (!batchSteered) {
+		UpdateNeighbors();
+	}
 	if(!_isAttacking) {
 		SetTargetPosition(playerCharacter->GetPosition());
-		UpdateMovement();
+		UpdateMovement(batchSteered);
 	}
 	HandleAttack();
 	_circleCollider.position = _position;
@@ -95,7 +101,7 @@ const ObjectType EnemyBoar::GetObjectType() const {
 	return _objectType;
 }
 
-const BehaviorData EnemyBoar::GetBehaviorData() const {
+const BehaviorData& EnemyBoar::GetBehaviorData() const {
 	return _behaviorData;
 }
 
@@ -127,7 +133,11 @@ const Vector2<float> EnemyBoar::GetVelocity() const {
 	return _velocity;
 }
 
-const std::vector<std::shared_ptr<ObjectBase>> EnemyBoar::GetQueriedObjects() const {
+const float EnemyBoar::GetTopSpeed() const {
+	return _dashSpeed > _behaviorData.maxSpeed ? _dashSpeed : _behaviorData.maxSpeed;
+}
+
+const std::vector<std::shared_ptr<ObjectBase>>& EnemyBoar::GetQueriedObjects() const {
 	return _queriedObjects;
 }
 
@@ -140,6 +150,7 @@ void EnemyBoar::ActivateEnemy(float orienation, Vector2<float> direction, Vector
 	_direction = direction;
 	_position = position;
 	_circleCollider.position = _position;
+	_neighborList.Invalidate();
 	Init();
 }
 
@@ -203,13 +214,20 @@ void EnemyBoar::SetVelocity(Vector2<float> velocity) {
 	_velocity = velocity;
 }
 
-void EnemyBoar::UpdateMovement() {
+void EnemyBoar::UpdateMovement(bool batchSteered) {
 	_behaviorData.targetPosition = playerCharacter->GetPosition();
 
 	_position += _velocity * deltaTime;
 	_orientation += _rotation * deltaTime;
 
-	_steeringOutput = _prioritySteering->Steering(_behaviorData, *this);
+	if (batchSteered) {
+		//ArriveBehavior sets the velocity to zero itself once the enemy is there
+		if (_batchStopped) {
+			_velocity = Vector2<float>(0.f, 0.f);
+		}
+	} else {
+		_steeringOutput = _prioritySteering->Steering(_behaviorData, *this);
+	}
 	_rotation += _steeringOutput.angularVelocity * deltaTime;
 	_velocity += _steeringOutput.linearVelocity * deltaTime;
 
@@ -30,12 +30,14 @@ public:
 	
 	const std::shared_ptr<Sprite> GetSprite() const override;
 	
-	const BehaviorData GetBehaviorData() const override;
+	const BehaviorData& GetBehaviorData() const override;
 
 	const Vector2<float> GetPosition() const override;
 	const Vector2<float> GetVelocity() const override;
+	//The dash is a lot faster than the boar walks
+	const float GetTopSpeed() const override;
 	
-	const std::vector<std::shared_ptr<ObjectBase>> GetQueriedObjects() const override;
+	const std::vector<std::shared_ptr<ObjectBase>>& GetQueriedObjects() const override;
 
 	const std::shared_ptr<WeaponComponent> GetWeaponComponent() const override;
 
@@ -49,7 +51,8 @@ public:
 	void SetVelocity(Vector2<float> velocity) override;
 
 private:
-	void UpdateMovement();
+	//Uses the steering the EnemyManager gave the enemy if batchSteered is true, otherwise its own PrioritySteering
+	void UpdateMovement(bool batchSteered);
 	
 	const char* _boarSprite = "res/sprites/MadBoar.png";
 
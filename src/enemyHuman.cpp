@@ -3,10 +3,12 @@
 #include "dataStructuresAndMethods.h"
 #include "debugDrawer.h"
 #include "gameEngine.h"
+#include "layeredSpatialIndex.h"
 #include "playerCharacter.h"
 #include "projectileManager.h"
 #include "quadTree.h"
 #include "steeringBehavior.h"
+#include "textureCache.h"
 #include "timerManager.h"
 #include "weaponComponent.h"
 
@@ -14,8 +16,7 @@
 
 EnemyHuman::EnemyHuman(unsigned int objectID, EnemyType enemyType) :
 	EnemyBase(objectID, enemyType) {
-	_sprite = std::make_shared<Sprite>();
-	_sprite->Load(_humanSprite);
+	_sprite = textureCache->GetSprite(_humanSprite);
 
 	_position = Vector2<float>(-10000.f, -10000.f);
 
@@ -59,9 +60,12 @@ void EnemyHuman::Init() {
 }
 
 void EnemyHuman::Update() {
-	_queriedObjects = objectBaseQuadTree->Query(_circleCollider);
+	const bool batchSteered = TakeBatchSteering();
+	if (!batchSteered) {
+		UpdateNeighbors();
+	}
 	SetTargetPosition(playerCharacter->GetPosition());
-	UpdateMovement();
+	UpdateMovement(batchSteered);
 	
 	HandleAttack();
 	_circleCollider.position = _position;
@@ -106,7 +110,7 @@ const std::shared_ptr<Sprite> EnemyHuman::GetSprite() const {
 	return _sprite;
 }
 
-const BehaviorData EnemyHuman::GetBehaviorData() const {
+const BehaviorData& EnemyHuman::GetBehaviorData() const {
 	return _behaviorData;
 }
 
@@ -118,7 +122,7 @@ const Vector2<float> EnemyHuman::GetVelocity() const {
 	return _velocity;
 }
 
-const std::vector<std::shared_ptr<ObjectBase>> EnemyHuman::GetQueriedObjects() const {
+const std::vector<std::shared_ptr<ObjectBase>>& EnemyHuman::GetQueriedObjects() const {
 	return _queriedObjects;
 }
 
@@ -131,6 +135,7 @@ void EnemyHuman::ActivateEnemy(float orienation, Vector2<float> direction, Vecto
 	_direction = direction;
 	_position = position;
 	_circleCollider.position = position;
+	_neighborList.Invalidate();
 	Init();
 }
 
@@ -170,10 +175,17 @@ bool EnemyHuman::TakeDamage(unsigned int damageAmount) {
 	return false;
 }
 
-void EnemyHuman::UpdateMovement() {
+void EnemyHuman::UpdateMovement(bool batchSteered) {
 	_position += _velocity * deltaTime;
 	_orientation += _rotation * deltaTime;
-	_steeringOutput = _prioritySteering->Steering(_behaviorData, *this);
+	if (batchSteered) {
+		//ArriveBehavior sets the velocity to zero itself once the enemy is there
+		if (_batchStopped) {
+			_velocity = Vector2<float>(0.f, 0.f);
+		}
+	} else {
+		_steeringOutput = _prioritySteering->Steering(_behaviorData, *this);
+	}
 	_rotation += _steeringOutput.angularVelocity * deltaTime;
 	_velocity += _steeringOutput.linearVelocity * deltaTime;
 
@@ -20,7 +20,7 @@ public:
 
 	bool TakeDamage(unsigned int damageAmount) override;
 
-	const BehaviorData GetBehaviorData() const override;
+	const BehaviorData& GetBehaviorData() const override;
 	const Circle GetCollider() const override;
 	const EnemyType GetEnemyType() const override;
 	const ObjectType GetObjectType() const override;
@@ -36,7 +36,7 @@ public:
 	const Vector2<float> GetPosition() const override;
 	const Vector2<float> GetVelocity() const override;
 	
-	const std::vector<std::shared_ptr<ObjectBase>> GetQueriedObjects() const override;
+	const std::vector<std::shared_ptr<ObjectBase>>& GetQueriedObjects() const override;
 
 	const std::shared_ptr<WeaponComponent> GetWeaponComponent() const override;
 
@@ -50,7 +50,8 @@ public:
 	void SetVelocity(Vector2<float> velocity) override;
 
 private:
-	void UpdateMovement();
+	//Uses the steering the EnemyManager gave the enemy if batchSteered is true, otherwise its own PrioritySteering
+	void UpdateMovement(bool batchSteered);
 	void PickWeapon();
 	const char* _humanSprite = "res/sprites/Human.png";
 };
@@ -4,17 +4,29 @@
 #include "enemyBoar.h"
 #include "enemyHuman.h"
 #include "gameEngine.h"
+#include "imGuiManager.h"
+#include "layeredSpatialIndex.h"
 #include "objectPool.h"
 #include "playerCharacter.h"
 #include "quadTree.h"
+#include "slabPool.h"
+#include "spriteBatcher.h"
 #include "steeringBehavior.h"
+#include "steeringEngine.h"
 #include "timerManager.h"
+#include "visibilityCuller.h"
 #include "weaponComponent.h"
 
 EnemyManager::EnemyManager() {
 	//Creates an unordered map with objectpool of the different enemy types
 	_enemyPools[EnemyType::Boar] = std::make_shared<ObjectPool<std::shared_ptr<EnemyBase>>>(_enemyAmountLimit);
 	_enemyPools[EnemyType::Human] = std::make_shared<ObjectPool<std::shared_ptr<EnemyBase>>>(_enemyAmountLimit);	
+	_enemyPools[EnemyType::Boar]->SetGrowthPolicy(_enemyGrowthChunk, _enemyGrowthThreshold);
+	_enemyPools[EnemyType::Human]->SetGrowthPolicy(_enemyGrowthChunk, _enemyGrowthThreshold);
+	_boarSlabs = std::make_shared<SlabPool<EnemyBoar>>(_enemiesPerSlab);
+	_humanSlabs = std::make_shared<SlabPool<EnemyHuman>>(_enemiesPerSlab);
+	_steeringEngine = std::make_shared<SteeringEngine>();
+	_steeringEngine->Reserve(_enemyAmountLimit);
 
 	_numberOfEnemyTypes = (unsigned int)EnemyType::Count;
 }
@@ -35,19 +47,25 @@ void EnemyManager::Init() {
 }
 
 void EnemyManager::Update() {
-	for (unsigned i = 0; i < _activeEnemies.size(); i++) {
-		_activeEnemies[i]->Update();
+	if (_batchSteering) {
+		SteerEnemies();
+	}
+	for (unsigned int k = 0; k < _numberOfEnemyTypes; k++) {
+		const std::vector<std::shared_ptr<EnemyBase>>& activeEnemies = _enemyPools[EnemyType(k)]->GetActiveObjects();
+		for (unsigned i = 0; i < activeEnemies.size(); i++) {
+			activeEnemies[i]->Update();
+		}
 	}
 }
 
 void EnemyManager::UpdateSurvival() {
-	if (_spawnTimer->GetTimerFinished() && _activeEnemies.size() < _enemyAmountLimit) {
+	if (_spawnTimer->GetTimerFinished() && GetActiveEnemyCount() < _enemyAmountLimit) {
 		SurvivalEnemySpawner();
 	}
 }
 
 void EnemyManager::UpdateTactical() {
-	if (_spawnTimer->GetTimerFinished() && _activeEnemies.size() < _enemyAmountLimit) {
+	if (_spawnTimer->GetTimerFinished() && GetActiveEnemyCount() < _enemyAmountLimit) {
 		TacticalEnemySpawner();
 	}	
 	for (unsigned int i = 0; i < _formationManagers.size(); i++) {
@@ -55,31 +73,62 @@ void EnemyManager::UpdateTactical() {
 	}
 }
 
+//All the enemies and their weapons are drawn in a few batches, one for each texture
+//Only the enemies the visibility culler found on the screen are drawn
 void EnemyManager::Render() {
-	for (unsigned i = 0; i < _activeEnemies.size(); i++) {
-		_activeEnemies[i]->Render();
+	const std::vector<std::shared_ptr<ObjectBase>>& visibleEnemies = visibilityCuller->GetVisibleObjects(CollisionLayer::Enemy);
+	spriteBatcher->Begin();
+	for (unsigned int i = 0; i < visibleEnemies.size(); i++) {
+		visibleEnemies[i]->Render();
 	}
+	spriteBatcher->End();
 }
 
-std::vector<std::shared_ptr<EnemyBase>> EnemyManager::GetActiveEnemies() {
+const std::vector<std::shared_ptr<EnemyBase>>& EnemyManager::GetActiveEnemies() {
+	_activeEnemies.clear();
+	for (unsigned int k = 0; k < _numberOfEnemyTypes; k++) {
+		const std::vector<std::shared_ptr<EnemyBase>>& poolEnemies = _enemyPools[EnemyType(k)]->GetActiveObjects();
+		_activeEnemies.insert(_activeEnemies.end(), poolEnemies.begin(), poolEnemies.end());
+	}
 	return _activeEnemies;
 }
 
-//Creates a specific enemy based on the enemyType enum
+unsigned int EnemyManager::GetActiveEnemyCount() {
+	unsigned int activeEnemyCount = 0;
+	for (unsigned int k = 0; k < _numberOfEnemyTypes; k++) {
+		activeEnemyCount += _enemyPools[EnemyType(k)]->ActiveSize();
+	}
+	return activeEnemyCount;
+}
+
 void EnemyManager::CreateNewEnemy(EnemyType enemyType, float orientation, Vector2<float> direction, Vector2<float> position) {
+	std::shared_ptr<EnemyBase> enemy = ConstructEnemy(enemyType);
+	if (enemy) {
+		_enemyPools[enemyType]->PoolObject(enemy);
+	}
+}
+
+//Creates a specific enemy based on the enemyType enum
+std::shared_ptr<EnemyBase> EnemyManager::ConstructEnemy(EnemyType enemyType) {
+	std::shared_ptr<EnemyBase> enemy = nullptr;
 	switch (enemyType) {
 	case EnemyType::Boar:
-		_enemyPools[enemyType]->PoolObject(std::make_shared<EnemyBoar>(_lastEnemyID, enemyType));
+		enemy = _boarSlabs->MakeShared(_lastEnemyID, enemyType);
 		break;
 
 	case EnemyType::Human:
-		_enemyPools[enemyType]->PoolObject(std::make_shared<EnemyHuman>(_lastEnemyID, enemyType));
+		enemy = _humanSlabs->MakeShared(_lastEnemyID, enemyType);
 		break;
 	
 	default:
 		break;
 	}	
 	_lastEnemyID++;
+	return enemy;
+}
+
+void EnemyManager::GrowPool(EnemyType enemyType) {
+	_enemyPools[enemyType]->Grow([this, enemyType]() { return ConstructEnemy(enemyType); });
 }
 
 void EnemyManager::TacticalEnemySpawner() {
@@ -107,9 +156,9 @@ void EnemyManager::TacticalEnemySpawner() {
 	}
 	anchorPoint.orientation = VectorAsOrientation(Vector2<float>(playerCharacter->GetPosition() - anchorPoint.position));
 	_formationManagers.emplace_back(std::make_shared<FormationManager>(FormationType::VShape, 9, anchorPoint));
-	while (_activeEnemies.size() < 9) {
-		enemyManager->SpawnEnemy(EnemyType::Human, anchorPoint.orientation, Vector2<float>(0.f, 0.f), anchorPoint.position);
-		_formationManagers.back()->AddCharacter(_activeEnemies.back());
+	//The enemies join the formation when the spawns are applied
+	while (GetActiveEnemyCount() + _commandBuffer.GetSpawnCount() < 9) {
+		enemyManager->SpawnEnemy(EnemyType::Human, anchorPoint.orientation, Vector2<float>(0.f, 0.f), anchorPoint.position, _formationManagers.back());
 	}
 	//_spawnTimer->DeactivateTimer();
 	_spawnTimer->ResetTimer();
@@ -147,116 +196,169 @@ void EnemyManager::SurvivalEnemySpawner() {
 			enemyManager->SpawnEnemy(EnemyType::Human, 0.f, Vector2<float>(0.f, 0.f), spawnPosition);
 		}
 	}
-	_spawnTimer->ResetTimer();
+	//The timer is only created in Init, and the benchmark never calls it before the manager is destroyed
+	if (_spawnTimer) {
+		_spawnTimer->ResetTimer();
+	}
 }
 
-//Spawn a specific enemy from the object pool. If the pool is empty, create a new enemy of that type
 void EnemyManager::SpawnEnemy(EnemyType enemyType, float orientation,
-	Vector2<float> direction, Vector2<float> position) {
-	if (_enemyPools[enemyType]->IsEmpty()) {
-		CreateNewEnemy(enemyType, orientation, direction, position);
+	Vector2<float> direction, Vector2<float> position, std::shared_ptr<FormationManager> formationManager) {
+	EnemySpawnCommand spawnCommand;
+	spawnCommand.enemyType = enemyType;
+	spawnCommand.orientation = orientation;
+	spawnCommand.direction = direction;
+	spawnCommand.position = position;
+	spawnCommand.formationManager = formationManager;
+	_commandBuffer.RecordSpawn(spawnCommand);
+}
+
+void EnemyManager::RemoveEnemy(EnemyType enemyType, PoolHandle poolHandle) {
+	_commandBuffer.RecordDespawn(enemyType, poolHandle);
+}
+
+void EnemyManager::ApplyCommands() {
+	_commandBuffer.Apply(
+		[this](EnemyType enemyType, PoolHandle poolHandle) { ApplyDespawn(enemyType, poolHandle); },
+		[this](const EnemySpawnCommand& spawnCommand) { ApplySpawn(spawnCommand); });
+	//Grown here so the next spawns don't have to make new enemies in the middle of the frame
+	for (unsigned int k = 0; k < _numberOfEnemyTypes; k++) {
+		if (_enemyPools[EnemyType(k)]->NeedsGrowth()) {
+			GrowPool(EnemyType(k));
+		}
 	}
-	//Then add the enemy to the active enemies vector which is called in Update
-	_activeEnemies.emplace_back(_enemyPools[enemyType]->SpawnObject());
-	_activeEnemies.back()->ActivateEnemy(orientation, direction, position);
 }
 
 void EnemyManager::RemoveAllEnemies() {
-	while (_activeEnemies.size() > 0) {
-		_activeEnemies.back()->DeactivateEnemy();
-		_enemyPools[_activeEnemies.back()->GetEnemyType()]->PoolObject(_activeEnemies.back());
-		_activeEnemies.pop_back();
+	_commandBuffer.Clear();
+	for (unsigned int k = 0; k < _numberOfEnemyTypes; k++) {
+		std::shared_ptr<ObjectPool<std::shared_ptr<EnemyBase>>> enemyPool = _enemyPools[EnemyType(k)];
+		while (enemyPool->ActiveSize() > 0) {
+			ApplyDespawn(EnemyType(k), enemyPool->GetHandle(enemyPool->ActiveSize() - 1));
+		}
 	}
 	_spawnTimer->ResetTimer();
 }
-//Using Quicksort and Binary search to locate a specific enemy
-void EnemyManager::RemoveEnemy(EnemyType enemyType, unsigned int objectID) {
-	if (_activeEnemies.empty()) {
-		return;
-	} else if (_activeEnemies.size() > 1) {
-		//Sorts the active enemies vector based on their ID from lowest to highest
-		QuickSort(0, _activeEnemies.size() - 1);
-		//Search through the sorted vector to find the enemy with a specific ID
-		_latestEnemyIndex = BinarySearch(0, _activeEnemies.size() - 1, objectID);
-		if (_latestEnemyIndex >= 0) {
-			//Deactivate the enemy by setting its position to a far away place
-			_activeEnemies[_latestEnemyIndex]->DeactivateEnemy();
-			//Adds the enemy to the object pool and place it at the back of the vector
-			_enemyPools[enemyType]->PoolObject(_activeEnemies[_latestEnemyIndex]);
-			std::swap(_activeEnemies[_latestEnemyIndex], _activeEnemies.back());
-		}
+
+bool EnemyManager::TakeDamage(EnemyType enemyType, PoolHandle poolHandle, unsigned int damageAmount) {
+	if (!_enemyPools[enemyType]->IsValid(poolHandle) || _commandBuffer.IsDespawnRecorded(enemyType, poolHandle)) {
+		return false;
+	}
+	if (_enemyPools[enemyType]->GetObject(poolHandle)->TakeDamage(damageAmount)) {
+		RemoveEnemy(enemyType, poolHandle);
 	}
-	//Removes the enemy from active enemies
-	_activeEnemies.pop_back();
+	return true;
 }
 
-void EnemyManager::TakeDamage(unsigned int enemyIndex, unsigned int damageAmount) {
-	if(_activeEnemies[enemyIndex]->TakeDamage(damageAmount)) {
-		RemoveEnemy(_activeEnemies[enemyIndex]->GetEnemyType(), enemyIndex);
-	}
+void EnemyManager::SetBatchSteering(bool batchSteering) {
+	_batchSteering = batchSteering;
 }
 
-void EnemyManager::UpdateQuadTree() {
-	for (unsigned i = 0; i < _activeEnemies.size(); i++) {
-		objectBaseQuadTree->Insert(_activeEnemies[i], _activeEnemies[i]->GetCollider());
-	}
+const float EnemyManager::GetFastestEnemySpeed() const {
+	return _fastestEnemySpeed;
 }
-//Binary search based on ID
-int EnemyManager::BinarySearch(int low, int high, int objectID) {
-	while (low <= high) {
-		int mid = low + (high - low) / 2;
 
-		if (_activeEnemies[mid]->GetObjectID() == objectID) {
-			return mid;
+void EnemyManager::SteerEnemies() {
+	_steeringEngine->Clear();
+	for (unsigned int k = 0; k < _numberOfEnemyTypes; k++) {
+		const std::vector<std::shared_ptr<EnemyBase>>& activeEnemies = _enemyPools[EnemyType(k)]->GetActiveObjects();
+		if (!activeEnemies.empty() && !_steeringEngine->HasArchetype(EnemyType(k))) {
+			_steeringEngine->SetArchetype(EnemyType(k), activeEnemies[0]->GetSteeringArchetype());
 		}
-
-		if (_activeEnemies[mid]->GetObjectID() < objectID) {
-			low = mid + 1;
-		} else {
-			high = mid - 1;
+		for (unsigned int i = 0; i < activeEnemies.size(); i++) {
+			//UpdateMovement moves and turns the enemy before it steers, so the engine gets the position and orientation it would have steered from
+			const EnemyBase& enemy = *activeEnemies[i];
+			_steeringEngine->AddAgent(EnemyType(k), enemy.GetPosition() + enemy.GetVelocity() * deltaTime, enemy.GetVelocity(),
+				enemy.GetOrientation() + enemy.GetRotation() * deltaTime, enemy.GetRotation(), playerCharacter->GetPosition());
 		}
 	}
-	return -1;
-}
-//Quicksort based on ID
-int EnemyManager::Partition(int start, int end) {
-	int pivot = _activeEnemies[start]->GetObjectID();
-
-	int count = 0;
-	for (int i = start + 1; i <= end; i++) {
-		if (_activeEnemies[i]->GetObjectID() <= pivot) {
-			count++;
+	_steeringEngine->Steer();
+
+	//The enemies are still in the same order they were added in
+	unsigned int agentIndex = 0;
+	for (unsigned int k = 0; k < _numberOfEnemyTypes; k++) {
+		const std::vector<std::shared_ptr<EnemyBase>>& activeEnemies = _enemyPools[EnemyType(k)]->GetActiveObjects();
+		for (unsigned int i = 0; i < activeEnemies.size(); i++) {
+			activeEnemies[i]->SetSteeringOutput(_steeringEngine->GetSteeringOutput(agentIndex), _steeringEngine->GetStopped(agentIndex));
+			agentIndex++;
 		}
 	}
+}
 
-	int pivotIndex = start + count;
-	std::swap(_activeEnemies[pivotIndex], _activeEnemies[start]);
-
-	int i = start, k = end;
-
-	while (i < pivotIndex && k > pivotIndex) {
-
-		while (_activeEnemies[i]->GetObjectID() <= pivot) {
-			i++;
-		}
+//Spawn a specific enemy from the object pool. If the pool is empty, grow it first and count the miss
+void EnemyManager::ApplySpawn(const EnemySpawnCommand& spawnCommand) {
+	const EnemyType enemyType = spawnCommand.enemyType;
+	PoolHandle poolHandle = _enemyPools[enemyType]->SpawnObject();
+	if (!_enemyPools[enemyType]->IsValid(poolHandle)) {
+		GrowPool(enemyType);
+		poolHandle = _enemyPools[enemyType]->SpawnObject();
+	}
+	//Then the enemy is among the active enemies of its pool, which are called in Update
+	std::shared_ptr<EnemyBase> enemy = _enemyPools[enemyType]->GetObject(poolHandle);
+	enemy->SetPoolHandle(poolHandle);
+	enemy->ActivateEnemy(spawnCommand.orientation, spawnCommand.direction, spawnCommand.position);
+	//Put in the index straight away so it's drawn this frame, and not only once the index is updated next frame
+	enemy->SetQuadTreeHandle(objectBaseQuadTree->Insert(CollisionLayer::Enemy, enemy, enemy->GetCollider()));
+	if (enemy->GetTopSpeed() > _fastestEnemySpeed) {
+		_fastestEnemySpeed = enemy->GetTopSpeed();
+	}
+	/*The cached neighbor lists around the new enemy were queried before it was there, so they're queried again.
+	The index can be a frame behind, so the range is grown by how far any enemy can have moved since then as well*/
+	Circle neighborRange = enemy->GetCollider();
+	neighborRange.radius += enemy->GetNeighborSkin() + _fastestEnemySpeed * deltaTime;
+	objectBaseQuadTree->Query(neighborRange, LayerBit(CollisionLayer::Enemy), _spawnNeighbors);
+	for (unsigned int i = 0; i < _spawnNeighbors.size(); i++) {
+		static_cast<EnemyBase*>(_spawnNeighbors[i].get())->InvalidateNeighbors();
+	}
+	_spawnNeighbors.clear();
+	if (spawnCommand.formationManager) {
+		spawnCommand.formationManager->AddCharacter(enemy);
+	}
+}
 
-		while (_activeEnemies[k]->GetObjectID() > pivot) {
-			k--;
-		}
+//The handle leads straight to the enemy, so it's swapped with the last active enemy of its pool and popped without searching for it
+void EnemyManager::ApplyDespawn(EnemyType enemyType, PoolHandle poolHandle) {
+	if (!_enemyPools[enemyType]->IsValid(poolHandle)) {
+		return;
+	}
+	std::shared_ptr<EnemyBase> enemy = _enemyPools[enemyType]->GetObject(poolHandle);
+	//Removes the enemy from the quadtree and deactivates it by setting its position to a far away place
+	objectBaseQuadTree->Remove(CollisionLayer::Enemy, enemy->GetQuadTreeHandle());
+	enemy->SetQuadTreeHandle(-1);
+	enemy->DeactivateEnemy();
+	_enemyPools[enemyType]->DespawnObject(poolHandle);
+}
 
-		if (i < pivotIndex && k > pivotIndex) {
-			std::swap(_activeEnemies[i++], _activeEnemies[k--]);
+void EnemyManager::UpdateQuadTree() {
+	_quadTreeObjects.clear();
+	_quadTreeColliders.clear();
+	_quadTreeHandles.clear();
+	for (unsigned int k = 0; k < _numberOfEnemyTypes; k++) {
+		const std::vector<std::shared_ptr<EnemyBase>>& activeEnemies = _enemyPools[EnemyType(k)]->GetActiveObjects();
+		for (unsigned i = 0; i < activeEnemies.size(); i++) {
+			_quadTreeObjects.emplace_back(activeEnemies[i]);
+			_quadTreeColliders.emplace_back(activeEnemies[i]->GetCollider());
+			_quadTreeHandles.emplace_back(activeEnemies[i]->GetQuadTreeHandle());
 		}
 	}
-	return pivotIndex;
+	objectBaseQuadTree->BulkUpdate(CollisionLayer::Enemy, _quadTreeObjects, _quadTreeColliders, _quadTreeHandles);
+	for (unsigned i = 0; i < _quadTreeObjects.size(); i++) {
+		_quadTreeObjects[i]->SetQuadTreeHandle(_quadTreeHandles[i]);
+	}
 }
 
-void EnemyManager::QuickSort(int start, int end) {
-	if (start >= end) {
-		return;
+void EnemyManager::ShowPoolStatistics() {
+	const char* labels[] = { "Boar enemies", "Human enemies" };
+	for (unsigned int k = 0; k < _numberOfEnemyTypes; k++) {
+		std::shared_ptr<ObjectPool<std::shared_ptr<EnemyBase>>> enemyPool = _enemyPools[EnemyType(k)];
+		imGuiHandler->ShowPoolStatistics("Object pools", labels[k], enemyPool->GetStatistics(), enemyPool->ActiveSize(), enemyPool->PoolSize());
 	}
-	int p = Partition(start, end);
+}
 
-	QuickSort(start, p - 1);
-	QuickSort(p + 1, end);
+void EnemyManager::WritePoolStatistics(std::ofstream& file) {
+	const char* labels[] = { "Boar enemies", "Human enemies" };
+	for (unsigned int k = 0; k < _numberOfEnemyTypes; k++) {
+		std::shared_ptr<ObjectPool<std::shared_ptr<EnemyBase>>> enemyPool = _enemyPools[EnemyType(k)];
+		::WritePoolStatistics(file, labels[k], enemyPool->GetStatistics(), enemyPool->ActiveSize(), enemyPool->PoolSize());
+	}
 }
@@ -1,17 +1,24 @@
 #pragma once
+#include "commandBuffer.h"
 #include "formationManager.h"
 #include "quadTree.h"
 #include "vector2.h"
 
+#include <fstream>
 #include <vector>
 #include <unordered_map>
 #include <memory>
 
 class EnemyBase;
+class EnemyBoar;
+class EnemyHuman;
 class SteeringBehavior;
+class SteeringEngine;
 class Timer;
 template<typename T> class ObjectPool;
+struct PoolHandle;
 template<typename T> class QuadTree;
+template<typename T> class SlabPool;
 
 enum class EnemyType;
 
@@ -80,6 +87,15 @@ struct BehaviorData {
 
 };
 
+struct EnemySpawnCommand {
+	EnemyType enemyType;
+	float orientation = 0.f;
+	Vector2<float> direction = Vector2<float>{ 0.f, 0.f };
+	Vector2<float> position = Vector2<float>{ 0.f, 0.f };
+	//The enemy is added to the formation once it has been spawned
+	std::shared_ptr<FormationManager> formationManager = nullptr;
+};
+
 class EnemyManager {
 public:
 	EnemyManager();
@@ -91,7 +107,9 @@ public:
 	void UpdateTactical();
 	void Render();
 
-	std::vector<std::shared_ptr<EnemyBase>> GetActiveEnemies();
+	//The active enemies of every type in one list, it stays the same until the next call
+	const std::vector<std::shared_ptr<EnemyBase>>& GetActiveEnemies();
+	unsigned int GetActiveEnemyCount();
 
 	void CreateNewEnemy(EnemyType enemyType, float orientation,
 		Vector2<float> direction, Vector2<float> position);
@@ -99,35 +117,76 @@ public:
 	void TacticalEnemySpawner();
 	void SurvivalEnemySpawner();
 
+	//The spawns and removals are recorded and only happen in ApplyCommands, so they can be asked for in the middle of any loop
 	void SpawnEnemy(EnemyType enemyType, float orientation,
-		Vector2<float> direction, Vector2<float> position);
+		Vector2<float> direction, Vector2<float> position, std::shared_ptr<FormationManager> formationManager = nullptr);
+	void RemoveEnemy(EnemyType enemyType, PoolHandle poolHandle);
+	//Called once a frame when nothing is looping over the enemies
+	void ApplyCommands();
 
+	//Removes every enemy straight away and throws away the recorded commands
 	void RemoveAllEnemies();
-	void RemoveEnemy(EnemyType enemyType, unsigned int objectID);
 
-	void TakeDamage(unsigned int enemyIndex, unsigned int damageAmount);
+	//Returns false if the enemy is already dead, so it can't be hit again before it's removed
+	bool TakeDamage(EnemyType enemyType, PoolHandle poolHandle, unsigned int damageAmount);
 
 	void UpdateQuadTree();
 
-	int BinarySearch(int low, int high, int objectID);
+	//Steers all the enemies at once with the SteeringEngine instead of one at a time with their PrioritySteering
+	void SetBatchSteering(bool batchSteering);
+
+	//The top speed of the fastest enemy that has been spawned
+	const float GetFastestEnemySpeed() const;
 
-	int Partition(int start, int end);
-	void QuickSort( int start, int end);
+	void ShowPoolStatistics();
+	void WritePoolStatistics(std::ofstream& file);
 
 private:
+	std::shared_ptr<EnemyBase> ConstructEnemy(EnemyType enemyType);
+	//Adds a chunk of new enemies to the pool
+	void GrowPool(EnemyType enemyType);
+
+	//Copies the enemies into the SteeringEngine, steers them and hands every enemy its steering for its next Update
+	void SteerEnemies();
+
+	void ApplySpawn(const EnemySpawnCommand& spawnCommand);
+	//Does nothing if the handle is stale, so an enemy that is already removed can't be removed twice
+	void ApplyDespawn(EnemyType enemyType, PoolHandle poolHandle);
+
 	std::vector<std::shared_ptr<FormationManager>> _formationManagers;
 
+	CommandBuffer<EnemyType, EnemySpawnCommand> _commandBuffer;
+
 	std::shared_ptr<Timer> _spawnTimer = nullptr;
 
-	std::vector<std::shared_ptr<EnemyBase>> _activeEnemies;
+	std::shared_ptr<SteeringEngine> _steeringEngine = nullptr;
+	bool _batchSteering = false;
+
+	float _fastestEnemySpeed = 0.f;
 
 	std::unordered_map<EnemyType, std::shared_ptr<ObjectPool<std::shared_ptr<EnemyBase>>>> _enemyPools;
+	//Where the enemies of each type are constructed, so the ones the update loops go through sit next to each other in memory
+	std::shared_ptr<SlabPool<EnemyBoar>> _boarSlabs;
+	std::shared_ptr<SlabPool<EnemyHuman>> _humanSlabs;
 
 	int _lastEnemyID = 1;
-	int _latestEnemyIndex = -1;
 
 	unsigned int _enemyAmountLimit = 1000;
+	unsigned int _enemiesPerSlab = 128;
+	//The pools are grown at the end of the frame once there are this few enemies left in them, instead of one enemy at a time when one runs out
+	unsigned int _enemyGrowthChunk = 64;
+	unsigned int _enemyGrowthThreshold = 16;
 	unsigned int _numberOfEnemyTypes = 0;
 	unsigned int _spawnNumberOfEnemies = 25;
+
+	//Filled by GetActiveEnemies, kept so it doesn't allocate a new list every time
+	std::vector<std::shared_ptr<EnemyBase>> _activeEnemies;
+	//Filled by ApplySpawn with the enemies close to the one that spawned
+	std::vector<std::shared_ptr<ObjectBase>> _spawnNeighbors;
+
+	//Filled by UpdateQuadTree every frame so the whole layer can be updated at once
+	std::vector<std::shared_ptr<ObjectBase>> _quadTreeObjects;
+	std::vector<Circle> _quadTreeColliders;
+	std::vector<int> _quadTreeHandles;
 };
 
@@ -0,0 +1,33 @@
+#include "fontRegistry.h"
+
+std::shared_ptr<Font> FontRegistry::GetFont(const char* path, int size) {
+	std::shared_ptr<Font>& font = _fonts[std::string(path) + ":" + std::to_string(size)];
+	if (font) {
+		return font;
+	}
+	font = std::make_shared<Font>();
+	font->font = TTF_OpenFont(path, size);
+	font->glyphAtlas.Build(font->font);
+	_loadCount++;
+	return font;
+}
+
+//The text sprites can still have the fonts after this, so the fonts are emptied instead of just let go
+void FontRegistry::Shutdown() {
+	for (std::unordered_map<std::string, std::shared_ptr<Font>>::iterator it = _fonts.begin(); it != _fonts.end(); it++) {
+		it->second->glyphAtlas.Destroy();
+		if (it->second->font) {
+			TTF_CloseFont(it->second->font);
+		}
+		it->second->font = nullptr;
+	}
+	_fonts.clear();
+}
+
+const unsigned int FontRegistry::GetLoadCount() const {
+	return _loadCount;
+}
+
+const unsigned int FontRegistry::GetFontCount() const {
+	return _fonts.size();
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <SDL2/SDL_ttf.h>
+
+#include "glyphAtlas.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+struct Font {
+	TTF_Font* font = nullptr;
+	GlyphAtlas glyphAtlas;
+};
+
+/*Opens every font once for each size it's used in and renders its glyph atlas at the same time, so all the text sprites with the same font share them.
+Unlike the textures the fonts are kept until the game shuts down, there are only a few of them and the states that use them come and go all the time*/
+class FontRegistry {
+public:
+	FontRegistry() {}
+	~FontRegistry() {}
+
+	std::shared_ptr<Font> GetFont(const char* path, int size);
+	//Closes the fonts and destroys their atlases, has to be done before the renderer is destroyed
+	void Shutdown();
+
+	//How many times a font has actually been opened
+	const unsigned int GetLoadCount() const;
+	const unsigned int GetFontCount() const;
+
+private:
+	//Keyed by the path and the size
+	std::unordered_map<std::string, std::shared_ptr<Font>> _fonts;
+
+	unsigned int _loadCount = 0;
+};
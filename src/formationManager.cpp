@@ -45,7 +45,7 @@ void FormationManager::UpdateSlots() {
 	Vector2<float> direction = Vector2<float>(playerCharacter->GetPosition() - _anchorPoint.position).normalized();
 	_anchorPoint.position += direction * deltaTime * 50.f;
 	_anchorPoint.orientation = VectorAsOrientation(direction);
-	debugDrawer->AddDebugCross(_anchorPoint.position, 25.f, { 75, 255, 175, 255 });
+	debugDrawer->AddDebugCross(DebugChannel::Formations, _anchorPoint.position, 25.f, { 75, 255, 175, 255 });
 
 	//Offsets each character based on the anchor point and current slot location
 	for (unsigned int i = 0; i < _slotAssignments.size(); i++) {
@@ -60,7 +60,9 @@ void FormationManager::UpdateSlots() {
 		_slotAssignments[i].enemyCharacter->SetTargetPosition(location.position);
 		_slotAssignments[i].enemyCharacter->SetTargetOrientation(location.orientation);
 
-		debugDrawer->AddDebugCross(location.position, 25.f, { 75, 255, 175, 255 });
+		if (debugDrawer->IsChannelEnabled(DebugChannel::Formations)) {
+			debugDrawer->AddDebugCross(DebugChannel::Formations, location.position, 25.f, { 75, 255, 175, 255 });
+		}
 	}
 }
 
@@ -150,13 +152,13 @@ void FormationManager::RemoveCharacter(std::shared_ptr<EnemyBase> enemyCharacter
 	ReconstructSlotAssignments();
 }
 
-std::vector<SlotAssignment> FormationManager::GetSlotAssignments() {
+const std::vector<SlotAssignment>& FormationManager::GetSlotAssignments() const {
 	return _slotAssignments;
 }
 
 void DefensiveCirclePattern::CreateSlots(unsigned int slotCount, AnchorPoint anchorPoint) {}
 
-unsigned int DefensiveCirclePattern::CalculateNumberOfSlots(std::vector<SlotAssignment> slotAssignments) {
+unsigned int DefensiveCirclePattern::CalculateNumberOfSlots(const std::vector<SlotAssignment>& slotAssignments) {
 	unsigned int filledSlots = 0;
 	for (unsigned int i = 0; i < slotAssignments.size(); i++) {
 		filledSlots = slotAssignments[i].slotNumber;
@@ -164,7 +166,7 @@ unsigned int DefensiveCirclePattern::CalculateNumberOfSlots(std::vector<SlotAssi
 	return filledSlots + 1;
 }
 
-AnchorPoint DefensiveCirclePattern::GetDriftOffset(std::vector<SlotAssignment> slotAssignments) {
+AnchorPoint DefensiveCirclePattern::GetDriftOffset(const std::vector<SlotAssignment>& slotAssignments) {
 	AnchorPoint result;
 	for (unsigned int i = 0; i < slotAssignments.size(); i++) {
 		AnchorPoint location = GetSlotLocation(slotAssignments[i].slotNumber, slotAssignments.size());
@@ -219,11 +221,11 @@ void SlotRolePattern::CreateSlots(unsigned int slotCount, AnchorPoint anchorPoin
 	_slotPositionAndType.emplace_back(SlotPositionAndType(8, AnchorPoint(anchorPoint.borderSide, Vector2(50.f, 0.f), 0), SlotAttackType::Melee));
 }
 
-unsigned int SlotRolePattern::CalculateNumberOfSlots(std::vector<SlotAssignment> slotAssignments) {
+unsigned int SlotRolePattern::CalculateNumberOfSlots(const std::vector<SlotAssignment>& slotAssignments) {
 	return slotAssignments.size();
 }
 
-AnchorPoint SlotRolePattern::GetDriftOffset(std::vector<SlotAssignment> slotAssignments) {
+AnchorPoint SlotRolePattern::GetDriftOffset(const std::vector<SlotAssignment>& slotAssignments) {
 	AnchorPoint result;
 	for (unsigned int i = 0; i < slotAssignments.size(); i++) {
 		AnchorPoint location = GetSlotLocation(slotAssignments[i].slotNumber, slotAssignments.size());
@@ -360,11 +362,11 @@ void VShapePattern::CreateSlots(unsigned int slotCount, AnchorPoint anchorPoint)
 	}
 }
 
-unsigned int VShapePattern::CalculateNumberOfSlots(std::vector<SlotAssignment> slotAssignments) {
+unsigned int VShapePattern::CalculateNumberOfSlots(const std::vector<SlotAssignment>& slotAssignments) {
 	return slotAssignments.size();
 }
 
-AnchorPoint VShapePattern::GetDriftOffset(std::vector<SlotAssignment> slotAssignments) {
+AnchorPoint VShapePattern::GetDriftOffset(const std::vector<SlotAssignment>& slotAssignments) {
 	AnchorPoint result;
 	for (unsigned int i = 0; i < slotAssignments.size(); i++) {
 		AnchorPoint location = GetSlotLocation(slotAssignments[i].slotNumber, slotAssignments.size());
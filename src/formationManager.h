@@ -57,9 +57,9 @@ public:
 
 	virtual void CreateSlots(unsigned int slotCount, AnchorPoint anchorPoint) = 0;
 
-	virtual unsigned int CalculateNumberOfSlots(std::vector<SlotAssignment> slotAssignments) = 0;
+	virtual unsigned int CalculateNumberOfSlots(const std::vector<SlotAssignment>& slotAssignments) = 0;
 
-	virtual AnchorPoint GetDriftOffset(std::vector<SlotAssignment> slotAssignments) = 0;
+	virtual AnchorPoint GetDriftOffset(const std::vector<SlotAssignment>& slotAssignments) = 0;
 	virtual AnchorPoint GetSlotLocation(unsigned int slotNumber, unsigned int numberOfSlots) = 0;
 
 	virtual float GetSlotCost(WeaponType weaponType, unsigned int index) = 0;
@@ -77,9 +77,9 @@ public:
 	~DefensiveCirclePattern() {}
 	void CreateSlots(unsigned int slotCount, AnchorPoint anchorPoint) override;
 
-	unsigned int CalculateNumberOfSlots(std::vector<SlotAssignment> slotAssignments) override;
+	unsigned int CalculateNumberOfSlots(const std::vector<SlotAssignment>& slotAssignments) override;
 
-	AnchorPoint GetDriftOffset(std::vector<SlotAssignment> slotAssignments) override;
+	AnchorPoint GetDriftOffset(const std::vector<SlotAssignment>& slotAssignments) override;
 	AnchorPoint GetSlotLocation(unsigned int slotNumber, unsigned int numberOfSlots) override;
 	float GetSlotCost(WeaponType weaponType, unsigned int index) override;
 
@@ -100,9 +100,9 @@ public:
 	~SlotRolePattern() {}
 	void CreateSlots(unsigned int maxAmountSlots, AnchorPoint anchorPoint) override;
 
-	unsigned int CalculateNumberOfSlots(std::vector<SlotAssignment> slotAssignments) override;
+	unsigned int CalculateNumberOfSlots(const std::vector<SlotAssignment>& slotAssignments) override;
 
-	AnchorPoint GetDriftOffset(std::vector<SlotAssignment> slotAssignments) override;
+	AnchorPoint GetDriftOffset(const std::vector<SlotAssignment>& slotAssignments) override;
 	AnchorPoint GetSlotLocation(unsigned int slotNumber, unsigned int numberOfSlots) override;
 
 	float GetSlotCost(WeaponType weaponType, unsigned int index) override;
@@ -126,9 +126,9 @@ public:
 
 	void CreateSlots(unsigned int slotCount, AnchorPoint anchorPoint) override;
 
-	unsigned int CalculateNumberOfSlots(std::vector<SlotAssignment> slotAssignments) override;
+	unsigned int CalculateNumberOfSlots(const std::vector<SlotAssignment>& slotAssignments) override;
 
-	AnchorPoint GetDriftOffset(std::vector<SlotAssignment> slotAssignments) override;
+	AnchorPoint GetDriftOffset(const std::vector<SlotAssignment>& slotAssignments) override;
 	AnchorPoint GetSlotLocation(unsigned int slotNumber, unsigned int numberOfSlots) override;
 
 	float GetSlotCost(WeaponType weaponType, unsigned int index) override;
@@ -156,7 +156,7 @@ public:
 	void ReconstructSlotAssignments();
 	void RemoveCharacter(std::shared_ptr<EnemyBase> enemyCharacter);
 
-	std::vector<SlotAssignment> GetSlotAssignments();
+	const std::vector<SlotAssignment>& GetSlotAssignments() const;
 
 private:
 	AnchorPoint _anchorPoint;
@@ -2,15 +2,20 @@
 
 #include "debugDrawer.h"
 #include "enemyManager.h"
+#include "fontRegistry.h"
 #include "imGuiManager.h"
+#include "layeredSpatialIndex.h"
 #include "obstacleManager.h"
 #include "playerCharacter.h"
 #include "projectileManager.h"
 #include "quadTree.h"
 #include "rayCast.h"
+#include "spriteBatcher.h"
 #include "stateStack.h"
 #include "steeringBehavior.h"
+#include "textureCache.h"
 #include "timerManager.h"
+#include "visibilityCuller.h"
 
 #include "enemyHuman.h"
 
@@ -21,15 +26,19 @@ SDL_Renderer* renderer;
 
 std::shared_ptr<EnemyManager> enemyManager;
 std::shared_ptr<DebugDrawer> debugDrawer;
+std::shared_ptr<FontRegistry> fontRegistry;
 std::shared_ptr<GameStateHandler> gameStateHandler;
 std::shared_ptr<ImGuiHandler> imGuiHandler;
 std::shared_ptr<ObstacleManager> obstacleManager;
 std::shared_ptr<PlayerCharacter> playerCharacter;
 std::shared_ptr<ProjectileManager> projectileManager;
-std::shared_ptr<QuadTree<std::shared_ptr<ObjectBase>>> objectBaseQuadTree;
+std::shared_ptr<LayeredSpatialIndex<std::shared_ptr<ObjectBase>>> objectBaseQuadTree;
 std::shared_ptr<RayCast> rayCast;
 std::shared_ptr<SteeringBehavior> separationBehavior;
+std::shared_ptr<SpriteBatcher> spriteBatcher;
+std::shared_ptr<TextureCache> textureCache;
 std::shared_ptr<TimerManager> timerManager;
+std::shared_ptr<VisibilityCuller> visibilityCuller;
 std::unordered_map<ButtonType, std::shared_ptr<Button>> _buttons;
 
 bool runningGame = false;
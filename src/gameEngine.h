@@ -14,6 +14,7 @@
 class Button;
 class DebugDrawer;
 class EnemyManager;
+class FontRegistry;
 class GameStateHandler;
 class ImGuiHandler;
 class ObjectBase;
@@ -21,28 +22,35 @@ class ObstacleManager;
 class PlayerCharacter;
 class ProjectileManager;
 class RayCast;
+class SpriteBatcher;
 class SteeringBehavior;
+class TextureCache;
 class TimerManager;
+class VisibilityCuller;
 
 enum class ButtonType;
 
 template<class T>
-class QuadTree;
+class LayeredSpatialIndex;
 
 extern SDL_Window* window;
 extern SDL_Renderer* renderer;
 
 extern std::shared_ptr<EnemyManager> enemyManager;
 extern std::shared_ptr<DebugDrawer> debugDrawer;
+extern std::shared_ptr<FontRegistry> fontRegistry;
 extern std::shared_ptr<GameStateHandler> gameStateHandler;
 extern std::shared_ptr<ImGuiHandler> imGuiHandler;
 extern std::shared_ptr<ObstacleManager> obstacleManager;
 extern std::shared_ptr<PlayerCharacter> playerCharacter;
 extern std::shared_ptr<ProjectileManager> projectileManager;
-extern std::shared_ptr<QuadTree<std::shared_ptr<ObjectBase>>> objectBaseQuadTree;
+extern std::shared_ptr<LayeredSpatialIndex<std::shared_ptr<ObjectBase>>> objectBaseQuadTree;
 extern std::shared_ptr<RayCast> rayCast;
 extern std::shared_ptr<SteeringBehavior> separationBehavior;
+extern std::shared_ptr<SpriteBatcher> spriteBatcher;
+extern std::shared_ptr<TextureCache> textureCache;
 extern std::shared_ptr<TimerManager> timerManager;
+extern std::shared_ptr<VisibilityCuller> visibilityCuller;
 
 
 extern std::unordered_map<ButtonType, std::shared_ptr<Button>> _buttons;
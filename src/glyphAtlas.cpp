@@ -0,0 +1,111 @@
+#include "glyphAtlas.h"
+#include "gameEngine.h"
+
+bool GlyphAtlas::Build(TTF_Font* font) {
+	Destroy();
+	if (!font) {
+		return false;
+	}
+	const SDL_Color white = { 255, 255, 255, 255 };
+	std::vector<SDL_Surface*> glyphSurfaces(_glyphs.size(), nullptr);
+	//The glyphs are put next to each other in rows, the atlas is as wide as the row limit and as high as the rows it needs
+	const int rowWidth = 512;
+	_lineHeight = TTF_FontHeight(font);
+	int x = 0;
+	int y = 0;
+	for (unsigned int i = 0; i < _glyphs.size(); i++) {
+		const Uint16 character = (Uint16)(firstCharacter + i);
+		int minX, maxX, minY, maxY, advance;
+		if (TTF_GlyphMetrics(font, character, &minX, &maxX, &minY, &maxY, &advance) != 0) {
+			continue;
+		}
+		_glyphs[i].advance = advance;
+		glyphSurfaces[i] = TTF_RenderGlyph_Blended(font, character, white);
+		if (!glyphSurfaces[i]) {
+			continue;
+		}
+		if (x + glyphSurfaces[i]->w > rowWidth) {
+			x = 0;
+			y += _lineHeight + 1;
+		}
+		_glyphs[i].rect = { x, y, glyphSurfaces[i]->w, glyphSurfaces[i]->h };
+		x += glyphSurfaces[i]->w + 1;
+	}
+	_width = rowWidth;
+	_height = y + _lineHeight + 1;
+
+	SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, _width, _height, 32, SDL_PIXELFORMAT_RGBA32);
+	for (unsigned int i = 0; i < glyphSurfaces.size(); i++) {
+		if (!glyphSurfaces[i]) {
+			continue;
+		}
+		SDL_Rect destination = _glyphs[i].rect;
+		SDL_SetSurfaceBlendMode(glyphSurfaces[i], SDL_BLENDMODE_NONE);
+		SDL_BlitSurface(glyphSurfaces[i], NULL, atlasSurface, &destination);
+		SDL_FreeSurface(glyphSurfaces[i]);
+	}
+	_texture = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+	SDL_SetTextureBlendMode(_texture, SDL_BLENDMODE_BLEND);
+	SDL_FreeSurface(atlasSurface);
+	return _texture != nullptr;
+}
+
+void GlyphAtlas::Destroy() {
+	if (_texture) {
+		SDL_DestroyTexture(_texture);
+	}
+	_texture = nullptr;
+	_width = 0;
+	_height = 0;
+	_lineHeight = 0;
+	_glyphs.fill(Glyph());
+}
+
+void GlyphAtlas::AddText(const std::string& text, SDL_FPoint position, SDL_Color color, std::vector<SDL_Vertex>& vertices, std::vector<int>& indices) const {
+	vertices.clear();
+	indices.clear();
+	if (!_texture) {
+		return;
+	}
+	float x = position.x;
+	for (unsigned int i = 0; i < text.size(); i++) {
+		if (text[i] < firstCharacter || text[i] > lastCharacter) {
+			continue;
+		}
+		const Glyph& glyph = _glyphs[text[i] - firstCharacter];
+		const float u0 = glyph.rect.x / (float)_width;
+		const float v0 = glyph.rect.y / (float)_height;
+		const float u1 = (glyph.rect.x + glyph.rect.w) / (float)_width;
+		const float v1 = (glyph.rect.y + glyph.rect.h) / (float)_height;
+		const int firstVertex = (int)vertices.size();
+		vertices.push_back({ { x, position.y }, color, { u0, v0 } });
+		vertices.push_back({ { x + glyph.rect.w, position.y }, color, { u1, v0 } });
+		vertices.push_back({ { x + glyph.rect.w, position.y + glyph.rect.h }, color, { u1, v1 } });
+		vertices.push_back({ { x, position.y + glyph.rect.h }, color, { u0, v1 } });
+		indices.push_back(firstVertex);
+		indices.push_back(firstVertex + 1);
+		indices.push_back(firstVertex + 2);
+		indices.push_back(firstVertex);
+		indices.push_back(firstVertex + 2);
+		indices.push_back(firstVertex + 3);
+		x += glyph.advance;
+	}
+}
+
+const int GlyphAtlas::GetTextWidth(const std::string& text) const {
+	int width = 0;
+	for (unsigned int i = 0; i < text.size(); i++) {
+		if (text[i] >= firstCharacter && text[i] <= lastCharacter) {
+			width += _glyphs[text[i] - firstCharacter].advance;
+		}
+	}
+	return width;
+}
+
+const int GlyphAtlas::GetLineHeight() const {
+	return _lineHeight;
+}
+
+SDL_Texture* GlyphAtlas::GetTexture() const {
+	return _texture;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+struct Glyph {
+	//Where the glyph is in the atlas texture, every glyph is as high as a line
+	SDL_Rect rect = { 0, 0, 0, 0 };
+	int advance = 0;
+};
+
+/*Every printable ASCII character of a font rendered once, in white, into one texture.
+Text is then drawn as one quad per character from that texture with a single SDL_RenderGeometry call,
+so changing the text only changes the quads and never makes a new surface or texture*/
+class GlyphAtlas {
+public:
+	GlyphAtlas() {}
+	~GlyphAtlas() {}
+
+	bool Build(TTF_Font* font);
+	void Destroy();
+
+	/*Clears the vertices and indices and fills them with the quads of the text, starting with the top left corner at the position.
+	Characters that aren't in the atlas are skipped*/
+	void AddText(const std::string& text, SDL_FPoint position, SDL_Color color, std::vector<SDL_Vertex>& vertices, std::vector<int>& indices) const;
+	//How wide the text is when it's drawn
+	const int GetTextWidth(const std::string& text) const;
+	const int GetLineHeight() const;
+
+	SDL_Texture* GetTexture() const;
+
+	static constexpr char firstCharacter = ' ';
+	static constexpr char lastCharacter = '~';
+
+private:
+	std::array<Glyph, lastCharacter - firstCharacter + 1> _glyphs;
+
+	SDL_Texture* _texture = nullptr;
+	int _width = 0;
+	int _height = 0;
+	int _lineHeight = 0;
+};
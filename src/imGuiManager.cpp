@@ -1,5 +1,6 @@
 #include "imGuiManager.h"
 #include "gameEngine.h"
+#include "objectPool.h"
 
 void ImGuiHandler::Init() {
 	IMGUI_CHECKVERSION();
@@ -7,7 +8,7 @@ void ImGuiHandler::Init() {
 	ImGuiIO& io = ImGui::GetIO(); (void)io;
 
 	ImGui_ImplSDL2_InitForSDLRenderer(window, renderer);
-	ImGuiSDL::Initialize(renderer, windowWidth, windowHeight);
+	ImGui_ImplSDLRenderer_Init(renderer);
 }
 
 void ImGuiHandler::ShowFloatValue(const char* name, const char* label, float a) {
@@ -58,13 +59,55 @@ void ImGuiHandler::SliderFloat(const char* name, const char* label, float& a,flo
 	ImGui::End();
 }
 
+void ImGuiHandler::ShowPoolStatistics(const char* name, const char* label, const PoolStatistics& statistics, unsigned int activeObjects, unsigned int pooledObjects) {
+	ImGui::Begin(name);
+	if (ImGui::CollapsingHeader(label, ImGuiTreeNodeFlags_DefaultOpen)) {
+		ImGui::Text("Active: %u, pooled: %u", activeObjects, pooledObjects);
+		ImGui::Text("High water mark: %u", statistics.highWaterMark);
+		ImGui::Text("Misses: %u", statistics.misses);
+		ImGui::Text("Growths: %u (%u objects)", statistics.growths, statistics.grownObjects);
+		ImGui::Text("Growing: %.3f ms, longest %.3f ms", statistics.growthMilliseconds, statistics.longestGrowthMilliseconds);
+	}
+	ImGui::End();
+}
+
+void ImGuiHandler::ShowCulling(const char* name, const char* label, unsigned int drawnObjects, unsigned int culledObjects) {
+	ImGui::Begin(name);
+	ImGui::Text("%s drawn: %u, culled: %u", label, drawnObjects, culledObjects);
+	ImGui::End();
+}
+
+bool ImGuiHandler::Button(const char* name, const char* label) {
+	ImGui::Begin(name);
+	const bool pressed = ImGui::Button(label);
+	ImGui::End();
+	return pressed;
+}
+
+void ImGuiHandler::Checkbox(const char* name, const char* label, bool& value) {
+	ImGui::Begin(name);
+	ImGui::Checkbox(label, &value);
+	ImGui::End();
+}
+
+void ImGuiHandler::ShowPerformance() {
+	const float framerate = ImGui::GetIO().Framerate;
+	ImGui::Begin("Performance");
+	ImGui::Text("Frame: %.3f ms (%.1f fps)", framerate > 0.f ? 1000.f / framerate : 0.f, framerate);
+	ImGui::Text("ImGui render: %.3f ms, %d vertices", _lastRenderMilliseconds, _lastVertexCount);
+	ImGui::End();
+}
+
 void ImGuiHandler::Render() {
+	const Uint64 startTicks = SDL_GetPerformanceCounter();
 	ImGui::Render();
-	ImGuiSDL::Render(ImGui::GetDrawData());
+	ImGui_ImplSDLRenderer_RenderDrawData(ImGui::GetDrawData());
+	_lastRenderMilliseconds = (double)(SDL_GetPerformanceCounter() - startTicks) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+	_lastVertexCount = ImGui::GetDrawData()->TotalVtxCount;
 }
 
 void ImGuiHandler::ShutDown() {
+	ImGui_ImplSDLRenderer_Shutdown();
 	ImGui_ImplSDL2_Shutdown();
-	ImGuiSDL::Deinitialize();
 	ImGui::DestroyContext();
 }
@@ -1,10 +1,12 @@
 #pragma once
 #include "ImGui/imgui.h"
-#include "ImGui/imgui_sdl.h"
 #include "ImGui/imgui_impl_sdl.h"
+#include "ImGui/imgui_impl_sdlrenderer.h"
 
 #include "vector2.h"
 
+struct PoolStatistics;
+
 class ImGuiHandler {
 public:
 	ImGuiHandler() {}
@@ -21,8 +23,19 @@ public:
 	void SliderFloat(const char* name, const char* label, float& a, float min, float max);
 	void SliderFloat2(const char* name, const char* label, float& a, float& b, float min, float max);
 
+	void ShowPoolStatistics(const char* name, const char* label, const PoolStatistics& statistics, unsigned int activeObjects, unsigned int pooledObjects);
+	void ShowCulling(const char* name, const char* label, unsigned int drawnObjects, unsigned int culledObjects);
+	bool Button(const char* name, const char* label);
+	//Shows how long the last frame and the last ImGui render took
+	void ShowPerformance();
+	void Checkbox(const char* name, const char* label, bool& value);
+
+	//Draws with SDL_RenderGeometry through imgui_impl_sdlrenderer, the old imgui_sdl backend rasterized every triangle itself and cached them in textures
 	void Render();
 	void ShutDown();
 
+private:
+	double _lastRenderMilliseconds = 0.0;
+	int _lastVertexCount = 0;
 };
 
@@ -0,0 +1 @@
+#include "layeredSpatialIndex.h"
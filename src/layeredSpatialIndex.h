@@ -0,0 +1,234 @@
+#pragma once
+#include "collision.h"
+#include "spatialIndex.h"
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+
+enum class CollisionLayer {
+	Enemy,
+	Projectile,
+	Player,
+	Count
+};
+
+//Queries pass a mask of the layers they want to look in, built by or-ing the bits together
+constexpr unsigned int LayerBit(CollisionLayer collisionLayer) {
+	return 1u << (unsigned int)collisionLayer;
+}
+
+constexpr unsigned int allCollisionLayers = (1u << (unsigned int)CollisionLayer::Count) - 1;
+
+/*Keeps one spatial index per collision layer, so a query only walks the layers it asked for.
+That way the enemies never look at or copy the projectiles when they search for their neighbors*/
+template<typename T>
+class LayeredSpatialIndex {
+public:
+	//Called once for every layer to create the index that layer uses
+	LayeredSpatialIndex(std::function<std::shared_ptr<SpatialIndex<T>>()> createIndex);
+	~LayeredSpatialIndex() {}
+
+	int Insert(CollisionLayer collisionLayer, T object, Circle circleCollider);
+	int Update(CollisionLayer collisionLayer, int handle, T object, Circle circleCollider);
+	void Remove(CollisionLayer collisionLayer, int handle);
+	void BulkUpdate(CollisionLayer collisionLayer, const std::vector<T>& objects, const std::vector<Circle>& circleColliders, std::vector<int>& handles);
+
+	//Clears the vector and fills it with the objects found in all the layers in the mask
+	void Query(Circle range, unsigned int layerMask, std::vector<T>& objectsFound);
+	bool Query(Circle range, unsigned int layerMask, QueryVisitor<T>& visitor);
+
+	void QueryNearest(Vector2<float> position, unsigned int k, float maxRadius, unsigned int layerMask,
+		std::vector<NearestObject<T>>& nearestObjects);
+
+	void QueryRange(AABB range, unsigned int layerMask, std::vector<T>& objectsFound);
+	bool QueryRange(AABB range, unsigned int layerMask, QueryVisitor<T>& visitor);
+
+	RayHit<T> QueryRay(Ray ray, unsigned int layerMask);
+
+	//Clears the vector and fills it with the overlaps between the colliders and the objects in all the layers in the mask
+	void QueryPairs(const std::vector<Circle>& circleColliders, unsigned int layerMask, std::vector<CollisionPair<T>>& pairs);
+
+	void Clear();
+	void EndFrame();
+
+	void Render();
+
+	const std::shared_ptr<SpatialIndex<T>> GetLayer(CollisionLayer collisionLayer) const;
+
+private:
+	std::array<std::shared_ptr<SpatialIndex<T>>, (unsigned int)CollisionLayer::Count> _layers;
+
+	//Used when more than one layer is queried, so the results can be added after each other without allocating
+	std::vector<T> _layerObjectsFound;
+	std::vector<NearestObject<T>> _layerNearestObjects;
+	std::vector<CollisionPair<T>> _layerPairs;
+};
+
+template<typename T>
+inline LayeredSpatialIndex<T>::LayeredSpatialIndex(std::function<std::shared_ptr<SpatialIndex<T>>()> createIndex) {
+	for (unsigned int i = 0; i < _layers.size(); i++) {
+		_layers[i] = createIndex();
+	}
+}
+
+template<typename T>
+inline int LayeredSpatialIndex<T>::Insert(CollisionLayer collisionLayer, T object, Circle circleCollider) {
+	return _layers[(unsigned int)collisionLayer]->Insert(object, circleCollider);
+}
+
+template<typename T>
+inline int LayeredSpatialIndex<T>::Update(CollisionLayer collisionLayer, int handle, T object, Circle circleCollider) {
+	return _layers[(unsigned int)collisionLayer]->Update(handle, object, circleCollider);
+}
+
+template<typename T>
+inline void LayeredSpatialIndex<T>::Remove(CollisionLayer collisionLayer, int handle) {
+	_layers[(unsigned int)collisionLayer]->Remove(handle);
+}
+
+template<typename T>
+inline void LayeredSpatialIndex<T>::BulkUpdate(CollisionLayer collisionLayer, const std::vector<T>& objects,
+	const std::vector<Circle>& circleColliders, std::vector<int>& handles) {
+	_layers[(unsigned int)collisionLayer]->BulkUpdate(objects, circleColliders, handles);
+}
+
+template<typename T>
+inline void LayeredSpatialIndex<T>::Query(Circle range, unsigned int layerMask, std::vector<T>& objectsFound) {
+	objectsFound.clear();
+	for (unsigned int i = 0; i < _layers.size(); i++) {
+		if ((layerMask & (1u << i)) == 0) {
+			continue;
+		}
+		//The first layer can be written straight into the vector, the rest are added after it
+		if (objectsFound.empty()) {
+			_layers[i]->Query(range, objectsFound);
+		} else {
+			_layers[i]->Query(range, _layerObjectsFound);
+			objectsFound.insert(objectsFound.end(), _layerObjectsFound.begin(), _layerObjectsFound.end());
+		}
+	}
+}
+
+template<typename T>
+inline bool LayeredSpatialIndex<T>::Query(Circle range, unsigned int layerMask, QueryVisitor<T>& visitor) {
+	for (unsigned int i = 0; i < _layers.size(); i++) {
+		if ((layerMask & (1u << i)) == 0) {
+			continue;
+		}
+		if (!_layers[i]->Query(range, visitor)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//Every layer after the first only has to look as far as the furthest of the k objects found so far
+template<typename T>
+inline void LayeredSpatialIndex<T>::QueryNearest(Vector2<float> position, unsigned int k, float maxRadius, unsigned int layerMask,
+	std::vector<NearestObject<T>>& nearestObjects) {
+	nearestObjects.clear();
+	for (unsigned int i = 0; i < _layers.size(); i++) {
+		if ((layerMask & (1u << i)) == 0) {
+			continue;
+		}
+		if (nearestObjects.empty()) {
+			_layers[i]->QueryNearest(position, k, maxRadius, nearestObjects);
+		} else {
+			_layers[i]->QueryNearest(position, k, NearestCutoff(nearestObjects, k, maxRadius), _layerNearestObjects);
+			for (unsigned int j = 0; j < _layerNearestObjects.size(); j++) {
+				AddNearestObject(nearestObjects, k, _layerNearestObjects[j].object, _layerNearestObjects[j].circleCollider, _layerNearestObjects[j].distance);
+			}
+		}
+	}
+}
+
+template<typename T>
+inline void LayeredSpatialIndex<T>::QueryRange(AABB range, unsigned int layerMask, std::vector<T>& objectsFound) {
+	objectsFound.clear();
+	for (unsigned int i = 0; i < _layers.size(); i++) {
+		if ((layerMask & (1u << i)) == 0) {
+			continue;
+		}
+		if (objectsFound.empty()) {
+			_layers[i]->QueryRange(range, objectsFound);
+		} else {
+			_layers[i]->QueryRange(range, _layerObjectsFound);
+			objectsFound.insert(objectsFound.end(), _layerObjectsFound.begin(), _layerObjectsFound.end());
+		}
+	}
+}
+
+template<typename T>
+inline bool LayeredSpatialIndex<T>::QueryRange(AABB range, unsigned int layerMask, QueryVisitor<T>& visitor) {
+	for (unsigned int i = 0; i < _layers.size(); i++) {
+		if ((layerMask & (1u << i)) == 0) {
+			continue;
+		}
+		if (!_layers[i]->QueryRange(range, visitor)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//The ray is shortened to the closest hit so far before the next layer is checked
+template<typename T>
+inline RayHit<T> LayeredSpatialIndex<T>::QueryRay(Ray ray, unsigned int layerMask) {
+	RayHit<T> closestRayHit;
+	for (unsigned int i = 0; i < _layers.size(); i++) {
+		if ((layerMask & (1u << i)) == 0) {
+			continue;
+		}
+		RayHit<T> rayHit = _layers[i]->QueryRay(ray);
+		if (rayHit.objectHit && (!closestRayHit.objectHit || rayHit.distance < closestRayHit.distance)) {
+			closestRayHit = rayHit;
+			ray.length = rayHit.distance;
+		}
+	}
+	return closestRayHit;
+}
+
+template<typename T>
+inline void LayeredSpatialIndex<T>::QueryPairs(const std::vector<Circle>& circleColliders, unsigned int layerMask,
+	std::vector<CollisionPair<T>>& pairs) {
+	pairs.clear();
+	for (unsigned int i = 0; i < _layers.size(); i++) {
+		if ((layerMask & (1u << i)) == 0) {
+			continue;
+		}
+		if (pairs.empty()) {
+			_layers[i]->QueryPairs(circleColliders, pairs);
+		} else {
+			_layers[i]->QueryPairs(circleColliders, _layerPairs);
+			pairs.insert(pairs.end(), _layerPairs.begin(), _layerPairs.end());
+		}
+	}
+}
+
+template<typename T>
+inline void LayeredSpatialIndex<T>::Clear() {
+	for (unsigned int i = 0; i < _layers.size(); i++) {
+		_layers[i]->Clear();
+	}
+}
+
+template<typename T>
+inline void LayeredSpatialIndex<T>::EndFrame() {
+	for (unsigned int i = 0; i < _layers.size(); i++) {
+		_layers[i]->EndFrame();
+	}
+}
+
+template<typename T>
+inline void LayeredSpatialIndex<T>::Render() {
+	for (unsigned int i = 0; i < _layers.size(); i++) {
+		_layers[i]->Render();
+	}
+}
+
+template<typename T>
+inline const std::shared_ptr<SpatialIndex<T>> LayeredSpatialIndex<T>::GetLayer(CollisionLayer collisionLayer) const {
+	return _layers[(unsigned int)collisionLayer];
+}
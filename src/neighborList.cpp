@@ -0,0 +1 @@
+#include "neighborList.h"
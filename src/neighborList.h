@@ -0,0 +1,73 @@
+#pragma once
+#include "collision.h"
+#include "vector2.h"
+
+#include <vector>
+
+/*A cached list of the objects around a collider, queried with the collider grown by a skin.
+The list is only queried again once the collider has moved more than half the skin since the last query,
+or once the fastest neighbor could have moved more than half the skin. As long as neither has happened,
+the collider and any neighbor can't have closed the skin between them, so nothing that overlaps the collider is missing from the list*/
+template<typename T>
+class NeighborList {
+public:
+	NeighborList(float skin = 16.f);
+	~NeighborList() {}
+
+	/*Calls the query with the grown range if the list is out of date, returns true if it did.
+	neighborStep is the furthest any neighbor can have moved since the last Update*/
+	template<typename Query>
+	bool Update(Circle circleCollider, float neighborStep, Query&& query);
+	//The next Update queries again, used when the object has been moved somewhere new
+	void Invalidate();
+
+	//Everything inside the grown range when it was last queried, so some of them may be further away than the collider reaches
+	const std::vector<T>& GetObjects() const;
+	const float GetSkin() const;
+
+private:
+	std::vector<T> _objects;
+	Vector2<float> _queryPosition = { 0.f, 0.f };
+
+	float _skin = 0.f;
+	float _neighborTravel = 0.f;
+	bool _valid = false;
+};
+
+template<typename T>
+inline NeighborList<T>::NeighborList(float skin) {
+	_skin = skin;
+}
+
+template<typename T>
+template<typename Query>
+inline bool NeighborList<T>::Update(Circle circleCollider, float neighborStep, Query&& query) {
+	_neighborTravel += neighborStep;
+	const Vector2<float> moved = circleCollider.position - _queryPosition;
+	const float halfSkin = _skin * 0.5f;
+	if (_valid && _neighborTravel <= halfSkin && moved.x * moved.x + moved.y * moved.y <= halfSkin * halfSkin) {
+		return false;
+	}
+	Circle range = circleCollider;
+	range.radius += _skin;
+	query(range, _objects);
+	_queryPosition = circleCollider.position;
+	_neighborTravel = 0.f;
+	_valid = true;
+	return true;
+}
+
+template<typename T>
+inline void NeighborList<T>::Invalidate() {
+	_valid = false;
+}
+
+template<typename T>
+inline const std::vector<T>& NeighborList<T>::GetObjects() const {
+	return _objects;
+}
+
+template<typename T>
+inline const float NeighborList<T>::GetSkin() const {
+	return _skin;
+}
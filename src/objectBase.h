@@ -1,4 +1,5 @@
 #pragma once
+#include "objectPool.h"
 #include "sprite.h"
 #include "vector2.h"
 
@@ -28,10 +29,23 @@ public:
 	virtual const std::shared_ptr<Sprite> GetSprite() const = 0;
 	virtual const Vector2<float> GetPosition() const = 0;
 
+	//The handle the spatial index gave the object when it was inserted
+	const int GetQuadTreeHandle() const { return _quadTreeHandle; }
+	void SetQuadTreeHandle(int quadTreeHandle) { _quadTreeHandle = quadTreeHandle; }
+	//The handle the object pool gave the object when it was spawned
+	const PoolHandle GetPoolHandle() const { return _poolHandle; }
+	void SetPoolHandle(PoolHandle poolHandle) { _poolHandle = poolHandle; }
+	//The last culling pass that found the object, so it isn't added twice when the spatial index still has an old entry for it
+	const unsigned int GetCullStamp() const { return _cullStamp; }
+	void SetCullStamp(unsigned int cullStamp) { _cullStamp = cullStamp; }
+
 
 protected:
 	float _orientation = 0.f;	
 	const unsigned int _objectID;
+	int _quadTreeHandle = -1;
+	PoolHandle _poolHandle;
+	unsigned int _cullStamp = 0;
 
 	const ObjectType _objectType = ObjectType::Count;
 
@@ -1 +1,9 @@
 #include "objectPool.h"
+
+#include <ostream>
+
+void WritePoolStatistics(std::ostream& file, const char* label, const PoolStatistics& statistics, unsigned int activeObjects, unsigned int pooledObjects) {
+	file << label << ", " << activeObjects << " active, " << pooledObjects << " pooled, " << statistics.highWaterMark << " high water mark, "
+		<< statistics.misses << " misses, " << statistics.growths << " growths, " << statistics.grownObjects << " grown objects, "
+		<< statistics.growthMilliseconds << " ms growing, " << statistics.longestGrowthMilliseconds << " ms longest growth\n";
+}
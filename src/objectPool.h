@@ -1,5 +1,34 @@
+#pragma once
+#include <chrono>
+#include <iosfwd>
+#include <utility>
 #include <vector>
 
+//Points at a spawned object in an ObjectPool, it goes stale as soon as that object is put back in the pool
+struct PoolHandle {
+	int slot = -1;
+	unsigned int generation = 0;
+};
+
+//What a pool has been through since it was made, so the pools can be sized for each game mode from real numbers
+struct PoolStatistics {
+	//The most objects that have been spawned at the same time
+	unsigned int highWaterMark = 0;
+	//How many times an object was asked for while the pool was empty
+	unsigned int misses = 0;
+	unsigned int growths = 0;
+	unsigned int grownObjects = 0;
+	double growthMilliseconds = 0.0;
+	double longestGrowthMilliseconds = 0.0;
+};
+
+//Writes one line with the statistics of a pool, label is what the pool holds
+void WritePoolStatistics(std::ostream& file, const char* label, const PoolStatistics& statistics, unsigned int activeObjects, unsigned int pooledObjects);
+
+/*Every object the pool creates gets a slot of its own that it keeps for as long as the pool lives.
+The spawned objects are also kept tightly packed in a vector of their own so they can be looped over, and each slot knows where its object is in it,
+so despawning is just swapping the object with the last one and popping it. The generation of a slot goes up every time its object is put back in the pool,
+that way a handle kept from before can't despawn the object again after it has been spawned for something else*/
 template<typename T>
 class ObjectPool {
 public:
@@ -9,41 +38,173 @@ public:
 	bool IsEmpty();
 
 	unsigned int PoolSize();
+	unsigned int ActiveSize();
+	//Adds a new object to the pool, ready to be spawned
 	void PoolObject(T object);
 
-	T SpawnObject();
+	//Counts a miss and returns a handle that isn't valid if the pool is empty
+	PoolHandle SpawnObject();
+	//Returns false if the handle is stale
+	bool DespawnObject(PoolHandle handle);
+
+	bool IsValid(PoolHandle handle);
+	//The handle has to be valid
+	T& GetObject(PoolHandle handle);
+	PoolHandle GetHandle(unsigned int activeIndex);
+	//Despawning moves the last active object into the place of the despawned one
+	const std::vector<T>& GetActiveObjects() const;
+
+	/*The pool grows by growthChunk objects at a time, and it should be grown as soon as there are no more than growthThreshold objects left in it,
+	that way it can be done where it suits the game instead of when something is spawned*/
+	void SetGrowthPolicy(unsigned int growthChunk, unsigned int growthThreshold);
+	bool NeedsGrowth();
+	//Pools growthChunk objects made by create() and times how long it took
+	template<typename Create>
+	void Grow(Create&& create);
+
+	const PoolStatistics& GetStatistics() const;
 
 private:
-	std::vector<T> _objectPool;
+	struct Slot {
+		T object;
+		unsigned int generation = 0;
+		int activeIndex = -1;
+	};
+
+	std::vector<Slot> _slots;
+	std::vector<unsigned int> _pooledSlots;
 
-	T _spawnedObject;
+	//The spawned objects and the slots they are in, at the same index
+	std::vector<T> _activeObjects;
+	std::vector<unsigned int> _activeSlots;
+
+	PoolStatistics _statistics;
+	unsigned int _growthChunk = 1;
+	unsigned int _growthThreshold = 0;
 };
 
 template<typename T>
 inline ObjectPool<T>::ObjectPool(unsigned int numberOfObjects) {
-	_objectPool.reserve(numberOfObjects);
+	_slots.reserve(numberOfObjects);
+	_pooledSlots.reserve(numberOfObjects);
+	_activeObjects.reserve(numberOfObjects);
+	_activeSlots.reserve(numberOfObjects);
 }
 
 template<typename T>
 inline bool ObjectPool<T>::IsEmpty() {
-	return _objectPool.empty();
+	return _pooledSlots.empty();
 }
 
 template<typename T>
 inline unsigned int ObjectPool<T>::PoolSize() {
-	return _objectPool.size();
+	return _pooledSlots.size();
+}
+
+template<typename T>
+inline unsigned int ObjectPool<T>::ActiveSize() {
+	return _activeObjects.size();
 }
 
 template<typename T>
 inline void ObjectPool<T>::PoolObject(T object) {
-	_objectPool.emplace_back(object);
+	Slot slot;
+	slot.object = object;
+	_pooledSlots.emplace_back((unsigned int)_slots.size());
+	_slots.emplace_back(slot);
+}
+
+template<typename T>
+inline PoolHandle ObjectPool<T>::SpawnObject() {
+	PoolHandle handle;
+	if (IsEmpty()) {
+		_statistics.misses++;
+		return handle;
+	}
+	const unsigned int slot = _pooledSlots.back();
+	_pooledSlots.pop_back();
+	_slots[slot].activeIndex = (int)_activeObjects.size();
+	_activeObjects.emplace_back(_slots[slot].object);
+	_activeSlots.emplace_back(slot);
+	handle.slot = (int)slot;
+	handle.generation = _slots[slot].generation;
+	if (_activeObjects.size() > _statistics.highWaterMark) {
+		_statistics.highWaterMark = _activeObjects.size();
+	}
+	return handle;
 }
 
 template<typename T>
-inline T ObjectPool<T>::SpawnObject() {
-	if (!IsEmpty()) {
-		_spawnedObject = _objectPool.back();
-		_objectPool.pop_back();
-		return _spawnedObject;
+inline bool ObjectPool<T>::DespawnObject(PoolHandle handle) {
+	if (!IsValid(handle)) {
+		return false;
 	}
+	Slot& slot = _slots[handle.slot];
+	const unsigned int lastSlot = _activeSlots.back();
+	std::swap(_activeObjects[slot.activeIndex], _activeObjects.back());
+	std::swap(_activeSlots[slot.activeIndex], _activeSlots.back());
+	_slots[lastSlot].activeIndex = slot.activeIndex;
+	_activeObjects.pop_back();
+	_activeSlots.pop_back();
+
+	slot.activeIndex = -1;
+	slot.generation++;
+	_pooledSlots.emplace_back((unsigned int)handle.slot);
+	return true;
+}
+
+template<typename T>
+inline bool ObjectPool<T>::IsValid(PoolHandle handle) {
+	return handle.slot >= 0 && handle.slot < (int)_slots.size() &&
+		_slots[handle.slot].generation == handle.generation && _slots[handle.slot].activeIndex >= 0;
+}
+
+template<typename T>
+inline T& ObjectPool<T>::GetObject(PoolHandle handle) {
+	return _activeObjects[_slots[handle.slot].activeIndex];
+}
+
+template<typename T>
+inline PoolHandle ObjectPool<T>::GetHandle(unsigned int activeIndex) {
+	PoolHandle handle;
+	handle.slot = (int)_activeSlots[activeIndex];
+	handle.generation = _slots[handle.slot].generation;
+	return handle;
+}
+
+template<typename T>
+inline const std::vector<T>& ObjectPool<T>::GetActiveObjects() const {
+	return _activeObjects;
+}
+
+template<typename T>
+inline void ObjectPool<T>::SetGrowthPolicy(unsigned int growthChunk, unsigned int growthThreshold) {
+	_growthChunk = growthChunk > 0 ? growthChunk : 1;
+	_growthThreshold = growthThreshold;
+}
+
+template<typename T>
+inline bool ObjectPool<T>::NeedsGrowth() {
+	return PoolSize() <= _growthThreshold;
+}
+
+template<typename T>
+template<typename Create>
+inline void ObjectPool<T>::Grow(Create&& create) {
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < _growthChunk; i++) {
+		PoolObject(create());
+	}
+	const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	_statistics.growths++;
+	_statistics.grownObjects += _growthChunk;
+	_statistics.growthMilliseconds += milliseconds;
+	if (milliseconds > _statistics.longestGrowthMilliseconds) {
+		_statistics.longestGrowthMilliseconds = milliseconds;
+	}
+}
+
+template<typename T>
+inline const PoolStatistics& ObjectPool<T>::GetStatistics() const {
+	return _statistics;
 }
@@ -22,6 +22,6 @@ void ObstacleManager::RenderObstacles() {
 	}
 }
 
-std::vector<std::shared_ptr<Wall>> const ObstacleManager::GetWalls() {
+const std::vector<std::shared_ptr<Wall>>& ObstacleManager::GetWalls() const {
 	return _walls;
 }
@@ -2,6 +2,8 @@
 #include "collision.h"
 #include "vector2.h"
 
+#include <array>
+#include <memory>
 #include <vector>
 
 class Wall;
@@ -16,7 +18,7 @@ public:
 	void UpdateObstacles();
 	void RenderObstacles();
 
-	const std::vector<std::shared_ptr<Wall>> const GetWalls();
+	const std::vector<std::shared_ptr<Wall>>& GetWalls() const;
 
 private:
 	std::vector<std::shared_ptr<Wall>> _walls;
@@ -11,14 +11,14 @@
 #include "projectileManager.h"
 #include "quadTree.h"
 #include "stateStack.h"
+#include "textureCache.h"
 #include "timerManager.h"
 
 #include <string>
 
 PlayerCharacter::PlayerCharacter(float characterOrientation, unsigned int objectID, Vector2<float> characterPosition) : 
 	ObjectBase(objectID, ObjectType::Player) {
-	_sprite = std::make_shared<Sprite>();
-	_sprite->Load(_kingSprite);
+	_sprite = textureCache->GetSprite(_kingSprite);
 
 	_orientation = characterOrientation;
 	_position = characterPosition;
@@ -4,11 +4,11 @@
 #include "enemyBoar.h"
 #include "enemyManager.h"
 #include "gameEngine.h"
+#include "textureCache.h"
 
 Projectile::Projectile(ProjectileType projectileType, const char* spritePath, unsigned int projectileDamage, unsigned int objectID) : 
 	ObjectBase(objectID, ObjectType::Projectile) {
-	_sprite = std::make_shared<Sprite>();
-	_sprite->Load(spritePath);
+	_sprite = textureCache->GetSprite(spritePath);
 	_projectileType = projectileType;
 	_projectileDamage = projectileDamage;
 
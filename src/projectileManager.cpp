@@ -5,14 +5,20 @@
 #include "enemyBase.h"
 #include "gameEngine.h"
 #include "imGuiManager.h"
+#include "layeredSpatialIndex.h"
 #include "objectPool.h"
 #include "playerCharacter.h"
 #include "quadTree.h"
+#include "slabPool.h"
+#include "spriteBatcher.h"
+#include "visibilityCuller.h"
 
 ProjectileManager::ProjectileManager() {
 	_numberOfProjectileTypes = (unsigned int)ProjectileType::Count;
 	for (unsigned int i = 0; i < _numberOfProjectileTypes; i++) {
 		_projectilePools[(ProjectileType)i] = std::make_shared<ObjectPool<std::shared_ptr<Projectile>>>(_projectileAmountLimit);
+		_projectilePools[(ProjectileType)i]->SetGrowthPolicy(_projectileGrowthChunk, _projectileGrowthThreshold);
+		_projectileSlabs[(ProjectileType)i] = std::make_shared<SlabPool<Projectile>>(_projectilesPerSlab);
 	}
 }
 
@@ -21,82 +27,142 @@ ProjectileManager::~ProjectileManager() {}
 void ProjectileManager::Init() {
 	for (unsigned int i = 0; i < _projectileAmountLimit; i++) {
 		if (i % 5 == 0) {
-			CreateNewProjectile(ProjectileType::PlayerProjectile, _playerProjectileSprite, 0.f, 30, {0.f, 0.f}, {-10000.f, -10000.f});
+			CreateNewProjectile(ProjectileType::PlayerProjectile, _playerProjectileSprite, 0.f, _playerProjectileDamage, {0.f, 0.f}, {-10000.f, -10000.f});
 		}
-		CreateNewProjectile(ProjectileType::EnemyProjectile, _enemyProjectileSprite, 0.f, 1, {0.f, 0.f}, {-10000.f, -10000.f});
+		CreateNewProjectile(ProjectileType::EnemyProjectile, _enemyProjectileSprite, 0.f, _enemyProjectileDamage, {0.f, 0.f}, {-10000.f, -10000.f});
 	}
 }
 
 void ProjectileManager::Update() {
-	for (unsigned int i = 0; i < _activeProjectiles.size(); i++) {
-		_activeProjectiles[i]->Update();
-		if (CheckCollision(_activeProjectiles[i]->GetProjectileType(), i)) {
-			continue;
+	for (unsigned int k = 0; k < _numberOfProjectileTypes; k++) {
+		const std::vector<std::shared_ptr<Projectile>>& activeProjectiles = _projectilePools[(ProjectileType)k]->GetActiveObjects();
+		for (unsigned int i = 0; i < activeProjectiles.size(); i++) {
+			activeProjectiles[i]->Update();
 		}
-		if (OutOfBorderX(_activeProjectiles[i]->GetPosition().x) ||
-			OutOfBorderY(_activeProjectiles[i]->GetPosition().y)) {
-			RemoveProjectile(_activeProjectiles[i]->GetProjectileType(), _activeProjectiles[i]->GetObjectID());
+	}
+	//The projectiles are put in the index after they have moved, so the hits are found where they are this frame
+	UpdateQuadTree();
+	CheckEnemyCollisions();
+	//The removals are only recorded, so nothing is moved around in the pools while they are looped over
+	for (unsigned int k = 0; k < _numberOfProjectileTypes; k++) {
+		const std::vector<std::shared_ptr<Projectile>>& activeProjectiles = _projectilePools[(ProjectileType)k]->GetActiveObjects();
+		for (unsigned int i = 0; i < activeProjectiles.size(); i++) {
+			if (CheckCollision((ProjectileType)k, i)) {
+				continue;
+			}
+			if (OutOfBorderX(activeProjectiles[i]->GetPosition().x) ||
+				OutOfBorderY(activeProjectiles[i]->GetPosition().y)) {
+				RemoveProjectile((ProjectileType)k, activeProjectiles[i]->GetPoolHandle());
+			}
 		}
 	}
 }
 
+//Only the projectiles the visibility culler found on the screen are drawn
 void ProjectileManager::Render() {
-	for (unsigned int i = 0; i < _activeProjectiles.size(); i++) {
-		_activeProjectiles[i]->Render();
+	const std::vector<std::shared_ptr<ObjectBase>>& visibleProjectiles = visibilityCuller->GetVisibleObjects(CollisionLayer::Projectile);
+	spriteBatcher->Begin();
+	for (unsigned int i = 0; i < visibleProjectiles.size(); i++) {
+		visibleProjectiles[i]->Render();
+	}
+	spriteBatcher->End();
+}
+
+unsigned int ProjectileManager::GetActiveProjectileCount() {
+	unsigned int activeProjectileCount = 0;
+	for (unsigned int k = 0; k < _numberOfProjectileTypes; k++) {
+		activeProjectileCount += _projectilePools[(ProjectileType)k]->ActiveSize();
 	}
+	return activeProjectileCount;
 }
 
 void ProjectileManager::CreateNewProjectile(ProjectileType projectileType, const char* spritePath, float orientation, unsigned int projectileDamage, Vector2<float> direction, Vector2<float> position) {
-	_projectilePools[projectileType]->PoolObject(std::make_shared<Projectile>(projectileType, spritePath, projectileDamage, _lastProjectileID));
+	_projectilePools[projectileType]->PoolObject(_projectileSlabs[projectileType]->MakeShared(projectileType, spritePath, projectileDamage, _lastProjectileID));
 	_lastProjectileID++;
 }
 
+void ProjectileManager::GrowPool(ProjectileType projectileType, const char* spritePath, unsigned int projectileDamage) {
+	_projectilePools[projectileType]->Grow([this, projectileType, spritePath, projectileDamage]() {
+		return _projectileSlabs[projectileType]->MakeShared(projectileType, spritePath, projectileDamage, _lastProjectileID++);
+	});
+}
+
 void ProjectileManager::SpawnProjectile(ProjectileType projectileType, const char* spritePath, float orientation, unsigned int projectileDamage, Vector2<float> direction, Vector2<float> position) {
-	if (_projectilePools[projectileType]->IsEmpty()) {
-		CreateNewProjectile(projectileType, spritePath, orientation, projectileDamage, direction, position);
-		_activeProjectiles.emplace_back(_projectilePools[projectileType]->SpawnObject());
-		_activeProjectiles.back()->ActivateProjectile(orientation, direction, position);
-	} else {
-		_activeProjectiles.emplace_back(_projectilePools[projectileType]->SpawnObject());
-		_activeProjectiles.back()->ActivateProjectile(orientation,direction, position);
-	}	
+	ProjectileSpawnCommand spawnCommand;
+	spawnCommand.projectileType = projectileType;
+	spawnCommand.spritePath = spritePath;
+	spawnCommand.orientation = orientation;
+	spawnCommand.projectileDamage = projectileDamage;
+	spawnCommand.direction = direction;
+	spawnCommand.position = position;
+	_commandBuffer.RecordSpawn(spawnCommand);
+}
+
+void ProjectileManager::RemoveProjectile(ProjectileType projectileType, PoolHandle poolHandle) {
+	_commandBuffer.RecordDespawn(projectileType, poolHandle);
 }
 
+void ProjectileManager::ApplyCommands() {
+	_commandBuffer.Apply(
+		[this](ProjectileType projectileType, PoolHandle poolHandle) { ApplyDespawn(projectileType, poolHandle); },
+		[this](const ProjectileSpawnCommand& spawnCommand) { ApplySpawn(spawnCommand); });
+	//Grown here so the next spawns don't have to make new projectiles in the middle of the frame
+	if (_projectilePools[ProjectileType::EnemyProjectile]->NeedsGrowth()) {
+		GrowPool(ProjectileType::EnemyProjectile, _enemyProjectileSprite, _enemyProjectileDamage);
+	}
+	if (_projectilePools[ProjectileType::PlayerProjectile]->NeedsGrowth()) {
+		GrowPool(ProjectileType::PlayerProjectile, _playerProjectileSprite, _playerProjectileDamage);
+	}
+}
+
+void ProjectileManager::ApplySpawn(const ProjectileSpawnCommand& spawnCommand) {
+	const ProjectileType projectileType = spawnCommand.projectileType;
+	PoolHandle poolHandle = _projectilePools[projectileType]->SpawnObject();
+	if (!_projectilePools[projectileType]->IsValid(poolHandle)) {
+		GrowPool(projectileType, spawnCommand.spritePath, spawnCommand.projectileDamage);
+		poolHandle = _projectilePools[projectileType]->SpawnObject();
+	}
+	std::shared_ptr<Projectile> projectile = _projectilePools[projectileType]->GetObject(poolHandle);
+	projectile->SetPoolHandle(poolHandle);
+	projectile->ActivateProjectile(spawnCommand.orientation, spawnCommand.direction, spawnCommand.position);
+	//Put in the index straight away so it's drawn this frame, and not only once the index is updated next frame
+	projectile->SetQuadTreeHandle(objectBaseQuadTree->Insert(CollisionLayer::Projectile, projectile, projectile->GetCollider()));
+}
+
+//Player projectiles are checked against the enemies in CheckEnemyCollisions. The index is into the active projectiles of the type's pool
 bool ProjectileManager::CheckCollision(ProjectileType projectileType, unsigned int projectileIndex) {
-	if (projectileType == ProjectileType::EnemyProjectile) {
-		if (IsInDistance(playerCharacter->GetPosition(), _activeProjectiles[projectileIndex]->GetPosition(),
-			_activeProjectiles[projectileIndex]->GetCollider().radius)) {
-			playerCharacter->TakeDamage(_activeProjectiles[projectileIndex]->GetProjectileDamage());
-			RemoveProjectile(projectileType, _activeProjectiles[projectileIndex]->GetObjectID());
-			return true;
-		}
+	if (projectileType != ProjectileType::EnemyProjectile) {
 		return false;
 	}
-	_objectsHit = objectBaseQuadTree->Query(_activeProjectiles[projectileIndex]->GetCollider());
-	for (unsigned int i = 0; i < _objectsHit.size(); i++) {
-		if (!_objectsHit[i]) {
+	std::shared_ptr<Projectile> projectile = _projectilePools[projectileType]->GetActiveObjects()[projectileIndex];
+	if (IsInDistance(playerCharacter->GetPosition(), projectile->GetPosition(), projectile->GetCollider().radius)) {
+		playerCharacter->TakeDamage(projectile->GetProjectileDamage());
+		RemoveProjectile(projectileType, projectile->GetPoolHandle());
+		return true;
+	}
+	return false;
+}
+
+/*The enemies and projectiles that are hit are only removed when the commands are applied, so they are still in the index while the pairs are gone through.
+An enemy that is already dead doesn't take the hit, so the pairs it's still in after that are skipped and the projectile can hit something else*/
+void ProjectileManager::CheckEnemyCollisions() {
+	objectBaseQuadTree->QueryPairs(_playerProjectileColliders, LayerBit(CollisionLayer::Enemy), _enemyHits);
+	_playerProjectileHit.assign(_playerProjectiles.size(), false);
+	for (unsigned int i = 0; i < _enemyHits.size(); i++) {
+		const unsigned int projectileIndex = _enemyHits[i].queryIndex;
+		//A projectile is used up by the first enemy it hits
+		if (_playerProjectileHit[projectileIndex] || !_enemyHits[i].object) {
 			continue;
 		}
-		if (projectileType == ProjectileType::PlayerProjectile) {
-			if (_objectsHit[i]->GetObjectType() == ObjectType::Enemy) {
-				_enemyHit = std::static_pointer_cast<EnemyBase>(_objectsHit[i]);	
-				//Returns true if the enemy dies
-				if (_enemyHit->TakeDamage(_activeProjectiles[projectileIndex]->GetProjectileDamage())) {
-					enemyManager->RemoveEnemy(_enemyHit->GetEnemyType(), _enemyHit->GetObjectID());
-				}
-				RemoveProjectile(projectileType, _activeProjectiles[projectileIndex]->GetObjectID());
-				return true;
-			}
-		} /*else if (projectileType == ProjectileType::EnemyProjectile) {
-			if (_objectsHit[i]->GetObjectType() == ObjectType::Player) {
-				playerCharacter->TakeDamage(_activeProjectiles[projectileIndex]->GetProjectileDamage());
-				RemoveProjectile(projectileType, _activeProjectiles[projectileIndex]->GetObjectID());
-				return true;
-			}
-		}*/
+		_enemyHit = std::static_pointer_cast<EnemyBase>(_enemyHits[i].object);
+		//Removes the enemy if it dies
+		if (!enemyManager->TakeDamage(_enemyHit->GetEnemyType(), _enemyHit->GetPoolHandle(), _playerProjectiles[projectileIndex]->GetProjectileDamage())) {
+			continue;
+		}
+		_playerProjectileHit[projectileIndex] = true;
+		RemoveProjectile(ProjectileType::PlayerProjectile, _playerProjectiles[projectileIndex]->GetPoolHandle());
 	}
-
-	return false;
+	_enemyHit = nullptr;
 }
 
 const char* ProjectileManager::GetEnemyProjectileSprite() const {
@@ -108,90 +174,62 @@ const char* ProjectileManager::GetPlayerProjectileSprite() const {
 }
 
 void ProjectileManager::RemoveAllProjectiles() {
-	while (_activeProjectiles.size() > 0) {
-		_activeProjectiles.back()->DeactivateProjectile();
-		_projectilePools[_activeProjectiles.back()->GetProjectileType()]->PoolObject(_activeProjectiles.back());
-		_activeProjectiles.pop_back();
+	_commandBuffer.Clear();
+	for (unsigned int k = 0; k < _numberOfProjectileTypes; k++) {
+		std::shared_ptr<ObjectPool<std::shared_ptr<Projectile>>> projectilePool = _projectilePools[(ProjectileType)k];
+		while (projectilePool->ActiveSize() > 0) {
+			ApplyDespawn((ProjectileType)k, projectilePool->GetHandle(projectilePool->ActiveSize() - 1));
+		}
 	}
 }
 
-void ProjectileManager::RemoveProjectile(ProjectileType projectileType, unsigned int projectileID) {
-	if (_activeProjectiles.empty()) {
+void ProjectileManager::ApplyDespawn(ProjectileType projectileType, PoolHandle poolHandle) {
+	if (!_projectilePools[projectileType]->IsValid(poolHandle)) {
 		return;
-	} else if (_activeProjectiles.size() > 1) {
-		QuickSort(0, _activeProjectiles.size() - 1);
-		_latestProjectileIndex = BinarySearch(0, _activeProjectiles.size() - 1, projectileID);
-		if (_latestProjectileIndex >= 0) {
-			_activeProjectiles[_latestProjectileIndex]->DeactivateProjectile();
-			_projectilePools[projectileType]->PoolObject(_activeProjectiles[_latestProjectileIndex]);
-			std::swap(_activeProjectiles[_latestProjectileIndex], _activeProjectiles.back());
-		}
-		_latestProjectileIndex = -1;
 	}
-	_activeProjectiles.pop_back();
+	std::shared_ptr<Projectile> projectile = _projectilePools[projectileType]->GetObject(poolHandle);
+	objectBaseQuadTree->Remove(CollisionLayer::Projectile, projectile->GetQuadTreeHandle());
+	projectile->SetQuadTreeHandle(-1);
+	projectile->DeactivateProjectile();
+	_projectilePools[projectileType]->DespawnObject(poolHandle);
 }
 
 void ProjectileManager::UpdateQuadTree() {
-	for (unsigned int i = 0; i < _activeProjectiles.size(); i++) {
-		objectBaseQuadTree->Insert(_activeProjectiles[i], _activeProjectiles[i]->GetCollider());
-	}
-}
-
-int ProjectileManager::BinarySearch(int low, int high, int targetID) {
-	while (low <= high) {
-		int mid = low + (high - low) / 2;
-
-		if (_activeProjectiles[mid]->GetObjectID() == targetID) {
-			return mid;
-		}
-
-		if (_activeProjectiles[mid]->GetObjectID() < targetID) {
-			low = mid + 1;
-		} else {
-			high = mid - 1;
+	_quadTreeObjects.clear();
+	_quadTreeColliders.clear();
+	_quadTreeHandles.clear();
+	_playerProjectiles.clear();
+	_playerProjectileColliders.clear();
+	for (unsigned int k = 0; k < _numberOfProjectileTypes; k++) {
+		const std::vector<std::shared_ptr<Projectile>>& activeProjectiles = _projectilePools[(ProjectileType)k]->GetActiveObjects();
+		for (unsigned int i = 0; i < activeProjectiles.size(); i++) {
+			_quadTreeObjects.emplace_back(activeProjectiles[i]);
+			_quadTreeColliders.emplace_back(activeProjectiles[i]->GetCollider());
+			_quadTreeHandles.emplace_back(activeProjectiles[i]->GetQuadTreeHandle());
+			if ((ProjectileType)k == ProjectileType::PlayerProjectile) {
+				_playerProjectiles.emplace_back(activeProjectiles[i]);
+				_playerProjectileColliders.emplace_back(_quadTreeColliders.back());
+			}
 		}
 	}
-	return -1;
-}
-
-int ProjectileManager::Partition(int start, int end) {
-	unsigned int pivot = _activeProjectiles[start]->GetObjectID();
-
-	int count = 0;
-	for (int i = start + 1; i <= end; i++) {
-		if (_activeProjectiles[i]->GetObjectID() <= pivot) {
-			count++;
-		}
+	objectBaseQuadTree->BulkUpdate(CollisionLayer::Projectile, _quadTreeObjects, _quadTreeColliders, _quadTreeHandles);
+	for (unsigned int i = 0; i < _quadTreeObjects.size(); i++) {
+		_quadTreeObjects[i]->SetQuadTreeHandle(_quadTreeHandles[i]);
 	}
+}
 
-	int pivotIndex = start + count;
-	std::swap(_activeProjectiles[pivotIndex], _activeProjectiles[start]);
-
-	int i = start, k = end;
-
-	while (i < pivotIndex && k > pivotIndex) {
-
-		while (_activeProjectiles[i]->GetObjectID() <= pivot) {
-			i++;
-		}
-
-		while (_activeProjectiles[k]->GetObjectID() > pivot) {
-			k--;
-		}
-
-		if (i < pivotIndex && k > pivotIndex) {
-			std::swap(_activeProjectiles[i++], _activeProjectiles[k--]);
-		}
+void ProjectileManager::ShowPoolStatistics() {
+	const char* labels[] = { "Enemy projectiles", "Player projectiles" };
+	for (unsigned int k = 0; k < _numberOfProjectileTypes; k++) {
+		std::shared_ptr<ObjectPool<std::shared_ptr<Projectile>>> projectilePool = _projectilePools[(ProjectileType)k];
+		imGuiHandler->ShowPoolStatistics("Object pools", labels[k], projectilePool->GetStatistics(), projectilePool->ActiveSize(), projectilePool->PoolSize());
 	}
-	return pivotIndex;
 }
 
-void ProjectileManager::QuickSort(int start, int end) {
-	if (start >= end) {
-		return;
+void ProjectileManager::WritePoolStatistics(std::ofstream& file) {
+	const char* labels[] = { "Enemy projectiles", "Player projectiles" };
+	for (unsigned int k = 0; k < _numberOfProjectileTypes; k++) {
+		std::shared_ptr<ObjectPool<std::shared_ptr<Projectile>>> projectilePool = _projectilePools[(ProjectileType)k];
+		::WritePoolStatistics(file, labels[k], projectilePool->GetStatistics(), projectilePool->ActiveSize(), projectilePool->PoolSize());
 	}
-	int p = Partition(start, end);
-
-	QuickSort(start, p - 1);
-	QuickSort(p + 1, end);
 }
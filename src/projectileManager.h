@@ -1,13 +1,25 @@
 #pragma once
+#include "commandBuffer.h"
 #include "projectile.h"
+#include "spatialIndex.h"
 
+#include <fstream>
 #include <unordered_map>
 #include <vector>
 
 template<typename T> class ObjectPool;
-
+template<typename T> class SlabPool;
 class EnemyBase;
 
+struct ProjectileSpawnCommand {
+	ProjectileType projectileType = ProjectileType::Count;
+	const char* spritePath = nullptr;
+	float orientation = 0.f;
+	unsigned int projectileDamage = 0;
+	Vector2<float> direction = Vector2<float>{ 0.f, 0.f };
+	Vector2<float> position = Vector2<float>{ 0.f, 0.f };
+};
+
 class ProjectileManager {
 public:
 	ProjectileManager();
@@ -17,7 +29,11 @@ public:
 	void Update();
 	void Render();
 
+	unsigned int GetActiveProjectileCount();
+
 	bool CheckCollision(ProjectileType projectileType, unsigned int projectileIndex);
+	//Finds every player projectile that hit an enemy with one pair query, instead of one query per projectile
+	void CheckEnemyCollisions();
 
 	const char* GetEnemyProjectileSprite() const;
 	const char* GetPlayerProjectileSprite() const;
@@ -25,32 +41,58 @@ public:
 	void CreateNewProjectile(ProjectileType projectileType, const char* spritePath, float orientation, unsigned int projectileDamage,
 		Vector2<float> direction, Vector2<float> position);
 	
+	//The spawns and removals are recorded and only happen in ApplyCommands, so they can be asked for in the middle of any loop
 	void SpawnProjectile(ProjectileType projectileType, const char* spritePath, float orientation, unsigned int projectileDamage, Vector2<float> direction, Vector2<float> position);
-	
-	void QuickSort(int start, int end);
-	
+	void RemoveProjectile(ProjectileType projectileType, PoolHandle poolHandle);
+	//Called once a frame when nothing is looping over the projectiles
+	void ApplyCommands();
+
+	//Removes every projectile straight away and throws away the recorded commands
 	void RemoveAllProjectiles();
-	void RemoveProjectile(ProjectileType projectileType, unsigned int projectileIndex);
 
 	void UpdateQuadTree();
 
-	int BinarySearch(int low, int high, int targetID);
-
-	int Partition(int start, int end);
+	void ShowPoolStatistics();
+	void WritePoolStatistics(std::ofstream& file);
 
 private:
+	//Adds a chunk of new projectiles to the pool
+	void GrowPool(ProjectileType projectileType, const char* spritePath, unsigned int projectileDamage);
+
+	void ApplySpawn(const ProjectileSpawnCommand& spawnCommand);
+	//Does nothing if the handle is stale
+	void ApplyDespawn(ProjectileType projectileType, PoolHandle poolHandle);
+
 	std::unordered_map<ProjectileType, std::shared_ptr<ObjectPool<std::shared_ptr<Projectile>>>> _projectilePools;
-	std::vector<std::shared_ptr<Projectile>> _activeProjectiles;
+	//Where the projectiles of each type are constructed, so the ones the update loops go through sit next to each other in memory
+	std::unordered_map<ProjectileType, std::shared_ptr<SlabPool<Projectile>>> _projectileSlabs;
 
+	CommandBuffer<ProjectileType, ProjectileSpawnCommand> _commandBuffer;
 	const char* _enemyProjectileSprite = "res/sprites/Fireball.png";
 	const char* _playerProjectileSprite = "res/sprites/Arcaneball.png";
 	
 	unsigned int _projectileAmountLimit = 2000;
+	unsigned int _projectilesPerSlab = 256;
+	//The pools are grown at the end of the frame once there are this few projectiles left in them, instead of one projectile at a time when one runs out
+	unsigned int _projectileGrowthChunk = 128;
+	unsigned int _projectileGrowthThreshold = 32;
+
+	unsigned int _enemyProjectileDamage = 1;
+	unsigned int _playerProjectileDamage = 30;
 	unsigned int _numberOfProjectileTypes = 0;
 
 	unsigned int _lastProjectileID = 0;
-	int _latestProjectileIndex = -1;
 
-	std::vector<std::shared_ptr<ObjectBase>> _objectsHit;
 	std::shared_ptr<EnemyBase> _enemyHit = nullptr;
+
+	//Filled by UpdateQuadTree every frame so the whole layer can be updated at once
+	std::vector<std::shared_ptr<ObjectBase>> _quadTreeObjects;
+	std::vector<Circle> _quadTreeColliders;
+	std::vector<int> _quadTreeHandles;
+
+	//The player projectiles are also gathered by UpdateQuadTree, since they are the only ones that can hit enemies
+	std::vector<std::shared_ptr<Projectile>> _playerProjectiles;
+	std::vector<Circle> _playerProjectileColliders;
+	std::vector<CollisionPair<std::shared_ptr<ObjectBase>>> _enemyHits;
+	std::vector<bool> _playerProjectileHit;
 };
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "quadTree.h"
 
+#include <functional>
+#include <thread>
+
 bool QuadTreeNode::Contains(Circle circleCollider) {
 	return AABBCircleIntersect(rectangle, circleCollider);
 }
@@ -7,3 +10,142 @@ bool QuadTreeNode::Contains(Circle circleCollider) {
 bool QuadTreeNode::Intersect(Circle range) {
 	return AABBCircleIntersect(rectangle, range);
 }
+
+bool QuadTreeNode::Encloses(Circle circleCollider) {
+	return circleCollider.position.x - circleCollider.radius >= rectangle.min.x &&
+		circleCollider.position.x + circleCollider.radius <= rectangle.max.x &&
+		circleCollider.position.y - circleCollider.radius >= rectangle.min.y &&
+		circleCollider.position.y + circleCollider.radius <= rectangle.max.y;
+}
+
+bool QuadTreeNode::Intersect(AABB range) {
+	return AABBIntersect(rectangle, range);
+}
+
+bool QuadTreeNode::Encloses(AABB box) {
+	return box.min.x >= rectangle.min.x && box.max.x <= rectangle.max.x &&
+		box.min.y >= rectangle.min.y && box.max.y <= rectangle.max.y;
+}
+
+std::array<int, 4> OrderFurthestFirst(const std::array<float, 4>& distances) {
+	std::array<int, 4> order = { 0, 1, 2, 3 };
+	for (int i = 1; i < 4; i++) {
+		for (int j = i; j > 0 && distances[order[j]] > distances[order[j - 1]]; j--) {
+			const int swap = order[j];
+			order[j] = order[j - 1];
+			order[j - 1] = swap;
+		}
+	}
+	return order;
+}
+
+namespace {
+	//Spreads the 16 bits out so there is an empty bit between each of them, for the other axis to go in
+	unsigned int SpreadBits(unsigned int value) {
+		value &= 0x0000ffff;
+		value = (value | (value << 8)) & 0x00ff00ff;
+		value = (value | (value << 4)) & 0x0f0f0f0f;
+		value = (value | (value << 2)) & 0x33333333;
+		value = (value | (value << 1)) & 0x55555555;
+		return value;
+	}
+
+	unsigned int QuantizeAxis(float position, float boundaryMin, float boundarySize) {
+		const float scaled = (position - boundaryMin) / boundarySize * 65536.f;
+		if (scaled <= 0.f) {
+			return 0;
+		}
+		return scaled >= 65535.f ? 65535 : (unsigned int)scaled;
+	}
+
+	void ComputeMortonCodeRange(const AABB& boundary, unsigned int maxDepth, const std::vector<Circle>& circleColliders,
+		std::vector<MortonCode>& mortonCodes, unsigned int begin, unsigned int end) {
+		for (unsigned int i = begin; i < end; i++) {
+			const Circle& circleCollider = circleColliders[i];
+			const unsigned int x = QuantizeAxis(circleCollider.position.x, boundary.min.x, boundary.width);
+			const unsigned int y = QuantizeAxis(circleCollider.position.y, boundary.min.y, boundary.height);
+
+			MortonCode& mortonCode = mortonCodes[i];
+			mortonCode.index = i;
+			//Child 0-3 is x + 2 * y in Subdevide, so the x bit goes below the y bit
+			mortonCode.code = SpreadBits(x) | (SpreadBits(y) << 1);
+			mortonCode.level = -1;
+
+			const float left = circleCollider.position.x - circleCollider.radius;
+			const float right = circleCollider.position.x + circleCollider.radius;
+			const float top = circleCollider.position.y - circleCollider.radius;
+			const float bottom = circleCollider.position.y + circleCollider.radius;
+			if (left < boundary.min.x || right > boundary.max.x || top < boundary.min.y || bottom > boundary.max.y) {
+				continue;
+			}
+			/*Walks down the children the code points to, the rectangles are made the same way as in Subdevide
+			so the floats match the nodes exactly. Once a child doesn't enclose the collider none of the deeper ones will*/
+			mortonCode.level = 0;
+			AABB rectangle = boundary;
+			for (unsigned int depth = 1; depth <= maxDepth; depth++) {
+				const unsigned int child = (mortonCode.code >> (32 - depth * 2)) & 3;
+				rectangle = AABB::makeFromPositionSize(Vector2<float>(
+					rectangle.position.x + (rectangle.width * ((child & 1) ? 0.25f : -0.25f)),
+					rectangle.position.y + (rectangle.height * ((child & 2) ? 0.25f : -0.25f))),
+					rectangle.height * 0.5f, rectangle.width * 0.5f);
+				if (left < rectangle.min.x || right > rectangle.max.x || top < rectangle.min.y || bottom > rectangle.max.y) {
+					break;
+				}
+				mortonCode.level = depth;
+			}
+		}
+	}
+}
+
+void ComputeMortonCodes(const AABB& boundary, unsigned int maxDepth, const std::vector<Circle>& circleColliders, std::vector<MortonCode>& mortonCodes) {
+	const unsigned int objectCount = circleColliders.size();
+	mortonCodes.resize(objectCount);
+
+	//Starting a thread costs more than computing a few thousand codes, so small frames stay on this thread
+	const unsigned int minimumObjectsPerThread = 4096;
+	unsigned int threadCount = std::thread::hardware_concurrency();
+	if (threadCount > objectCount / minimumObjectsPerThread) {
+		threadCount = objectCount / minimumObjectsPerThread;
+	}
+	if (threadCount <= 1) {
+		ComputeMortonCodeRange(boundary, maxDepth, circleColliders, mortonCodes, 0, objectCount);
+		return;
+	}
+	//Every thread writes to its own part of the vector, so they don't have to be synchronized
+	const unsigned int objectsPerThread = (objectCount + threadCount - 1) / threadCount;
+	std::vector<std::thread> threads;
+	for (unsigned int i = 1; i < threadCount; i++) {
+		const unsigned int begin = i * objectsPerThread;
+		const unsigned int end = begin + objectsPerThread < objectCount ? begin + objectsPerThread : objectCount;
+		threads.emplace_back(ComputeMortonCodeRange, std::cref(boundary), maxDepth, std::cref(circleColliders),
+			std::ref(mortonCodes), begin, end);
+	}
+	ComputeMortonCodeRange(boundary, maxDepth, circleColliders, mortonCodes, 0, objectsPerThread);
+	for (unsigned int i = 0; i < threads.size(); i++) {
+		threads[i].join();
+	}
+}
+
+void RadixSortMortonCodes(std::vector<MortonCode>& mortonCodes, std::vector<MortonCode>& sortBuffer) {
+	sortBuffer.resize(mortonCodes.size());
+	for (unsigned int shift = 0; shift < 32; shift += 8) {
+		std::array<unsigned int, 256> offsets = {};
+		for (unsigned int i = 0; i < mortonCodes.size(); i++) {
+			offsets[(mortonCodes[i].code >> shift) & 0xff]++;
+		}
+		//When every code has the same 8 bits the pass wouldn't move anything, which is common for the low bits of a small tree
+		if (offsets[mortonCodes.empty() ? 0 : (mortonCodes[0].code >> shift) & 0xff] == mortonCodes.size()) {
+			continue;
+		}
+		unsigned int offset = 0;
+		for (unsigned int i = 0; i < offsets.size(); i++) {
+			const unsigned int count = offsets[i];
+			offsets[i] = offset;
+			offset += count;
+		}
+		for (unsigned int i = 0; i < mortonCodes.size(); i++) {
+			sortBuffer[offsets[(mortonCodes[i].code >> shift) & 0xff]++] = mortonCodes[i];
+		}
+		mortonCodes.swap(sortBuffer);
+	}
+}
@@ -1,8 +1,10 @@
 #pragma once
 #include "collision.h"
+#include "spatialIndex.h"
 #include "vector2.h"
 
 #include <array>
+#include <cmath>
 #include <vector>
 
 #include "debugDrawer.h"
@@ -13,78 +15,253 @@ struct QuadTreeNode {
 
 	bool Contains(Circle circleCollider);
 	bool Intersect(Circle range);
+	bool Intersect(AABB range);
+	//True if the whole circle is inside the node, not just a part of it
+	bool Encloses(Circle circleCollider);
+	bool Encloses(AABB box);
 };
 
-template<typename T> 
-class QuadTree {
+//Returns the indices 0-3 ordered from the largest to the smallest distance, used to push the closest child last so it's visited first
+std::array<int, 4> OrderFurthestFirst(const std::array<float, 4>& distances);
+
+/*Used by QuadTree::BulkUpdate. The center of the collider is scaled to 16 bits per axis inside the boundary,
+and the x and y bits are interleaved so every 2 bits from the top are the child the center is in on the next level*/
+struct MortonCode {
+	unsigned int code = 0;
+	unsigned int index = 0;
+	//The deepest level where the node around the center encloses the whole collider, -1 if it's not inside the boundary at all
+	int level = -1;
+};
+
+//The colliders are split between threads when there are enough of them to pay for starting the threads
+void ComputeMortonCodes(const AABB& boundary, unsigned int maxDepth, const std::vector<Circle>& circleColliders, std::vector<MortonCode>& mortonCodes);
+//Sorts 8 bits at a time, codes that are equal keep their order so the same input always gives the same tree
+void RadixSortMortonCodes(std::vector<MortonCode>& mortonCodes, std::vector<MortonCode>& sortBuffer);
+
+/*Counted while the tree is built and queried, used to check if the capacity and max depth fit the amount of objects.
+The numbers are for one frame and are saved when the frame ends*/
+struct QuadTreeStats {
+	/*Objects that are partly or fully outside the boundary. These used to be dropped by Insert,
+	now they are kept in a list of their own next to the root*/
+	unsigned int outOfBoundsInserts = 0;
+	//One slot for every level down to QuadTree::maxDepthLimit
+	std::array<unsigned int, 17> straddlersPerLevel = {};
+
+	unsigned int queries = 0;
+	unsigned int nodesVisited = 0;
+	unsigned int objectsTested = 0;
+};
+
+/*All nodes and inserted objects live in two flat vectors that are linked by index instead of pointers.
+Clear() only resets the size of the vectors, so the memory allocated during a busy frame is reused the next frame.
+An object is only moved down into a child if the child encloses the whole collider,
+objects that overlap the edges between the children are kept in the straddler list of the node instead.
+Objects that aren't fully inside the boundary are kept in a separate list that is only checked by queries close to the edge*/
+template<typename T>
+class QuadTree : public SpatialIndex<T> {
 public:
-	QuadTree(QuadTreeNode boundary, unsigned int capacity);
+	QuadTree(QuadTreeNode boundary, unsigned int capacity, unsigned int maxDepth = 8);
 	~QuadTree();
 
-	bool Insert(T object, Circle circleCollider);
+	int Insert(T object, Circle circleCollider) override;
+	int Update(int handle, T object, Circle circleCollider) override;
+	void Remove(int handle) override;
+	//Clears the tree and builds it again from the colliders sorted in morton order
+	void BulkUpdate(const std::vector<T>& objects, const std::vector<Circle>& circleColliders, std::vector<int>& handles) override;
+
+	std::vector<T> Query(Circle range) override;
+	void Query(Circle range, std::vector<T>& objectsFound) override;
+	bool Query(Circle range, QueryVisitor<T>& visitor) override;
 
-	std::vector<T> Query(Circle range);
+	void QueryNearest(Vector2<float> position, unsigned int k, float maxRadius, std::vector<NearestObject<T>>& nearestObjects) override;
 
-	void Clear();
+	void QueryRange(AABB range, std::vector<T>& objectsFound) override;
+	bool QueryRange(AABB range, QueryVisitor<T>& visitor) override;
 
-	void Subdevide();
+	RayHit<T> QueryRay(Ray ray) override;
 
-	void Render();
+	//Calls the callback with every object the range hit, stops if the callback returns false. The range can be a Circle or an AABB
+	template<typename Range, typename Callback>
+	bool ForEachInRange(Range range, Callback&& callback);
+
+	void Clear() override;
+	void EndFrame() override;
+
+	void Render() override;
+
+	const unsigned int GetNodeCount() const;
+	const unsigned int GetObjectCount() const;
+	const unsigned int GetStraddlerCount() const;
+
+	const QuadTreeStats& GetStats() const;
+	//The stats from the last frame that ended, the tree is cleared at the same time so GetStats() would be empty
+	const QuadTreeStats& GetLastFrameStats() const;
+
+	//Query walks the tree with a fixed size stack, this is the deepest it can go
+	static constexpr unsigned int maxDepthLimit = 16;
 
 private:
-	QuadTreeNode _upperLeft;
-	QuadTreeNode _upperRight;
-	QuadTreeNode _lowerLeft;
-	QuadTreeNode _lowerRight;
+	struct Node {
+		QuadTreeNode quadTreeNode;
+		int firstChild = -1;
+		int firstObject = -1;
+		unsigned int objectCount = 0;
+		int firstStraddler = -1;
+		unsigned int straddlerCount = 0;
+		float largestStraddlerRadius = 0.f;
+		unsigned int depth = 0;
+	};
 
-	bool _divided = false;
+	struct InsertedObject {
+		T object;
+		Circle circleCollider;
+		int nextObject = -1;
+	};
+
+	void Subdevide(int nodeIndex);
+
+	int AddObject(int nodeIndex, T object, Circle circleCollider);
+	int AddStraddler(int nodeIndex, T object, Circle circleCollider);
+	int AddOutOfBounds(T object, Circle circleCollider);
+
+	template<typename Range, typename Callback>
+	bool VisitList(int firstObject, Range range, Callback& callback);
+	void VisitNearest(int firstObject, Vector2<float> position, unsigned int k, float maxRadius, std::vector<NearestObject<T>>& nearestObjects);
+	void VisitRay(int firstObject, Ray ray, RayHit<T>& rayHit);
 
 	unsigned int _capacity = 0;
+	unsigned int _maxDepth = 0;
+	unsigned int _straddlerCount = 0;
+	int _firstOutOfBounds = -1;
+	float _largestOutOfBoundsRadius = 0.f;
 	QuadTreeNode _quadTreeNode;
 
-	std::array<std::shared_ptr<QuadTree<T>>, 4> _quadTreeChildren;
-	std::vector<T> _objectsInserted;
-	std::vector<Circle> _circleColliders;
+	QuadTreeStats _stats;
+	QuadTreeStats _lastFrameStats;
+
+	std::vector<Node> _nodes;
+	std::vector<InsertedObject> _objectsInserted;
+
+	//Kept between frames so BulkUpdate doesn't allocate
+	std::vector<MortonCode> _mortonCodes;
+	std::vector<MortonCode> _sortBuffer;
 };
 template<typename T>
-inline QuadTree<T>::QuadTree(QuadTreeNode boundary, unsigned int capacity) {
+inline QuadTree<T>::QuadTree(QuadTreeNode boundary, unsigned int capacity, unsigned int maxDepth) {
 	_quadTreeNode = boundary;
 	_capacity = capacity;
+	_maxDepth = maxDepth < maxDepthLimit ? maxDepth : maxDepthLimit;
 
-	_quadTreeChildren[0] = nullptr;
-	_quadTreeChildren[1] = nullptr;
-	_quadTreeChildren[2] = nullptr;
-	_quadTreeChildren[3] = nullptr;
+	Clear();
 }
 template<typename T>
 inline QuadTree<T>::~QuadTree() {
 	Clear();
 }
 
-//Inserts an object into the quadtree node if the circle collider is in that node
+/*Walks down from the root and puts the object in the first node that isn't full.
+Objects outside the boundary are kept in their own list, so nothing is lost for the frame*/
 template<typename T>
-inline bool QuadTree<T>::Insert(T object, Circle circleCollider) {
-	if (!_quadTreeNode.Contains(circleCollider)) {
-		return false;
+inline int QuadTree<T>::Insert(T object, Circle circleCollider) {
+	if (!_nodes[0].quadTreeNode.Encloses(circleCollider)) {
+		return AddOutOfBounds(object, circleCollider);
 	}
-	//If the node is at its max capacity it will subdevide into 4 nodes
-	if (_objectsInserted.size() < _capacity) {
-		_objectsInserted.emplace_back(object);
-		_circleColliders.emplace_back(circleCollider);
-		return true;
-	} else {
-		if (!_divided) {
-			Subdevide();
+	int nodeIndex = 0;
+	while (true) {
+		if (_nodes[nodeIndex].firstChild < 0) {
+			//If the node is at its max capacity it will subdevide into 4 nodes, unless it's already at the max depth
+			if (_nodes[nodeIndex].objectCount < _capacity || _nodes[nodeIndex].depth >= _maxDepth) {
+				return AddObject(nodeIndex, object, circleCollider);
+			}
+			Subdevide(nodeIndex);
 		}
-		//After subdividing it checks if it can insert the object in one of the children nodes
-		if (_quadTreeChildren[0]->Insert(object, circleCollider)) {
-			return true;
-		} else if (_quadTreeChildren[1]->Insert(object, circleCollider)) {
-			return true;
-		} else if (_quadTreeChildren[2]->Insert(object, circleCollider)) {
-			return true;
-		} else if (_quadTreeChildren[3]->Insert(object, circleCollider)) {
-			return true;
+		//Continues down into the child that the whole collider fits in
+		int childIndex = -1;
+		for (int i = 0; i < 4; i++) {
+			if (_nodes[_nodes[nodeIndex].firstChild + i].quadTreeNode.Encloses(circleCollider)) {
+				childIndex = _nodes[nodeIndex].firstChild + i;
+				break;
+			}
+		}
+		if (childIndex < 0) {
+			return AddStraddler(nodeIndex, object, circleCollider);
+		}
+		nodeIndex = childIndex;
+	}
+}
+//The tree is rebuilt every frame, so the handle from the last frame is no longer valid
+template<typename T>
+inline int QuadTree<T>::Update(int handle, T object, Circle circleCollider) {
+	return Insert(object, circleCollider);
+}
+//Removed objects stay in the tree until it is cleared at the end of the frame
+template<typename T>
+inline void QuadTree<T>::Remove(int handle) {}
+/*After sorting, the objects of every node are next to each other in the morton code vector, so a node only has to count
+its range to know if it should subdevide, and the range is split into the children by the 2 bits for the next level.
+Objects that were placed higher up are still in the ranges of the children, their level is used to skip them.
+Unlike Insert, the layout only depends on the colliders and not on the order the objects were inserted in*/
+template<typename T>
+inline void QuadTree<T>::BulkUpdate(const std::vector<T>& objects, const std::vector<Circle>& circleColliders, std::vector<int>& handles) {
+	Clear();
+	handles.resize(objects.size());
+	ComputeMortonCodes(_quadTreeNode.rectangle, _maxDepth, circleColliders, _mortonCodes);
+	RadixSortMortonCodes(_mortonCodes, _sortBuffer);
+
+	for (unsigned int i = 0; i < _mortonCodes.size(); i++) {
+		if (_mortonCodes[i].level < 0) {
+			const unsigned int index = _mortonCodes[i].index;
+			handles[index] = AddOutOfBounds(objects[index], circleColliders[index]);
+		}
+	}
+
+	struct BuildRange {
+		int nodeIndex = 0;
+		unsigned int begin = 0;
+		unsigned int end = 0;
+	};
+	//Same as the queries, a node is split into 4 ranges and one of them is built right away, so 3 slots per level is enough
+	std::array<BuildRange, maxDepthLimit * 3 + 1> rangesToBuild;
+	unsigned int stackSize = 0;
+	rangesToBuild[stackSize++] = { 0, 0, (unsigned int)_mortonCodes.size() };
+
+	while (stackSize > 0) {
+		const BuildRange buildRange = rangesToBuild[--stackSize];
+		const int depth = _nodes[buildRange.nodeIndex].depth;
+
+		unsigned int objectCount = 0;
+		for (unsigned int i = buildRange.begin; i < buildRange.end; i++) {
+			if (_mortonCodes[i].level >= depth) {
+				objectCount++;
+			}
+		}
+		if (objectCount <= _capacity || depth >= (int)_maxDepth) {
+			for (unsigned int i = buildRange.begin; i < buildRange.end; i++) {
+				if (_mortonCodes[i].level >= depth) {
+					const unsigned int index = _mortonCodes[i].index;
+					handles[index] = AddObject(buildRange.nodeIndex, objects[index], circleColliders[index]);
+				}
+			}
+			continue;
+		}
+		Subdevide(buildRange.nodeIndex);
+		const int firstChild = _nodes[buildRange.nodeIndex].firstChild;
+		const unsigned int shift = 30 - depth * 2;
+		unsigned int childBegin = buildRange.begin;
+		for (unsigned int child = 0; child < 4; child++) {
+			unsigned int childEnd = childBegin;
+			while (childEnd < buildRange.end && ((_mortonCodes[childEnd].code >> shift) & 3) == child) {
+				//Enclosed by this node but not by the child, so it overlaps the lines between the children
+				if (_mortonCodes[childEnd].level == depth) {
+					const unsigned int index = _mortonCodes[childEnd].index;
+					handles[index] = AddStraddler(buildRange.nodeIndex, objects[index], circleColliders[index]);
+				}
+				childEnd++;
+			}
+			if (childEnd > childBegin) {
+				rangesToBuild[stackSize++] = { firstChild + (int)child, childBegin, childEnd };
+			}
+			childBegin = childEnd;
 		}
 	}
 }
@@ -92,88 +269,765 @@ inline bool QuadTree<T>::Insert(T object, Circle circleCollider) {
 template<typename T>
 inline std::vector<T> QuadTree<T>::Query(Circle range) {
 	std::vector<T> objectsFound;
-	//Checks if the collider is inside the quadtree node
-	if (_quadTreeNode.Intersect(range)) {
-		/*Loops through all the items in the node, checks if they are interacting with the collider.
-		If it does, add it to the vector*/
-		for (unsigned int i = 0; i < _objectsInserted.size(); i++) {
-			if (CircleIntersect(range, _circleColliders[i])) {
-				objectsFound.emplace_back(_objectsInserted[i]);
+	Query(range, objectsFound);
+	return objectsFound;
+}
+
+template<typename T>
+inline void QuadTree<T>::Query(Circle range, std::vector<T>& objectsFound) {
+	objectsFound.clear();
+	ForEachInRange(range, [&objectsFound](const T& object, const Circle& circleCollider) {
+		objectsFound.emplace_back(object);
+		return true;
+	});
+}
+
+template<typename T>
+inline bool QuadTree<T>::Query(Circle range, QueryVisitor<T>& visitor) {
+	return ForEachInRange(range, [&visitor](const T& object, const Circle& circleCollider) {
+		return visitor.Visit(object, circleCollider);
+	});
+}
+
+template<typename T>
+inline void QuadTree<T>::QueryRange(AABB range, std::vector<T>& objectsFound) {
+	objectsFound.clear();
+	ForEachInRange(range, [&objectsFound](const T& object, const Circle& circleCollider) {
+		objectsFound.emplace_back(object);
+		return true;
+	});
+}
+
+template<typename T>
+inline bool QuadTree<T>::QueryRange(AABB range, QueryVisitor<T>& visitor) {
+	return ForEachInRange(range, [&visitor](const T& object, const Circle& circleCollider) {
+		return visitor.Visit(object, circleCollider);
+	});
+}
+
+template<typename T>
+template<typename Range, typename Callback>
+inline bool QuadTree<T>::ForEachInRange(Range range, Callback&& callback) {
+	_stats.queries++;
+	const AABB bounds = RangeBounds(range);
+	//The objects outside the boundary can only be hit if the range reaches that far out
+	if (_firstOutOfBounds >= 0) {
+		AABB reach = AABB::makeFromPositionSize(bounds.position,
+			bounds.height + _largestOutOfBoundsRadius * 4.f, bounds.width + _largestOutOfBoundsRadius * 4.f);
+		if (!_nodes[0].quadTreeNode.Encloses(reach) && !VisitList(_firstOutOfBounds, range, callback)) {
+			return false;
+		}
+	}
+	//Instead of recursing, the nodes left to visit are kept in a stack that never needs more than 3 slots per level
+	std::array<int, maxDepthLimit * 3 + 1> nodesToVisit;
+	unsigned int stackSize = 0;
+	nodesToVisit[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		Node& node = _nodes[nodesToVisit[--stackSize]];
+		//Checks if the collider is inside the quadtree node
+		if (!node.quadTreeNode.Intersect(range)) {
+			continue;
+		}
+		_stats.nodesVisited++;
+		/*Every straddler overlaps one of the lines through the center of the node,
+		so they only have to be checked if the range is close enough to one of those lines*/
+		if (node.firstStraddler >= 0) {
+			const float reach = node.largestStraddlerRadius * 2.f;
+			const Vector2<float> center = node.quadTreeNode.rectangle.position;
+			const bool nearLineX = center.x >= bounds.min.x - reach && center.x <= bounds.max.x + reach;
+			const bool nearLineY = center.y >= bounds.min.y - reach && center.y <= bounds.max.y + reach;
+			if ((nearLineX || nearLineY) && !VisitList(node.firstStraddler, range, callback)) {
+				return false;
 			}
 		}
-		/*If the node has divided, the query function is called from every child
-		Then I insert the queried objects from all the children into the objectsFound vector*/
-		if (_divided) {
-			std::vector<T> objectsFoundInChild;
-			if (_quadTreeChildren[0]) {
-				objectsFoundInChild = _quadTreeChildren[0]->Query(range);
-				objectsFound.insert(objectsFound.end(), objectsFoundInChild.begin(), objectsFoundInChild.end());
+		//Checks the objects in the node, and passes the ones the collider hit to the callback
+		if (!VisitList(node.firstObject, range, callback)) {
+			return false;
+		}
+		if (node.firstChild >= 0) {
+			for (int i = 0; i < 4; i++) {
+				nodesToVisit[stackSize++] = node.firstChild + i;
 			}
-			if (_quadTreeChildren[1]) {
-				objectsFoundInChild = _quadTreeChildren[1]->Query(range);
-				objectsFound.insert(objectsFound.end(), objectsFoundInChild.begin(), objectsFoundInChild.end());
+		}
+	}
+	return true;
+}
+/*Visits the closest nodes first, once k objects have been found every node further away than the furthest of them is skipped.
+The center of every object is inside the node it's stored in, so the distance to the node is never more than the distance to the object*/
+template<typename T>
+inline void QuadTree<T>::QueryNearest(Vector2<float> position, unsigned int k, float maxRadius, std::vector<NearestObject<T>>& nearestObjects) {
+	nearestObjects.clear();
+	_stats.queries++;
+	if (_firstOutOfBounds >= 0) {
+		Circle reach;
+		reach.position = position;
+		reach.radius = maxRadius + _largestOutOfBoundsRadius * 2.f;
+		if (!_nodes[0].quadTreeNode.Encloses(reach)) {
+			VisitNearest(_firstOutOfBounds, position, k, maxRadius, nearestObjects);
+		}
+	}
+	std::array<int, maxDepthLimit * 3 + 1> nodesToVisit;
+	unsigned int stackSize = 0;
+	nodesToVisit[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		Node& node = _nodes[nodesToVisit[--stackSize]];
+		if (PointAABBDistance(position, node.quadTreeNode.rectangle) > NearestCutoff(nearestObjects, k, maxRadius)) {
+			continue;
+		}
+		_stats.nodesVisited++;
+		VisitNearest(node.firstStraddler, position, k, maxRadius, nearestObjects);
+		VisitNearest(node.firstObject, position, k, maxRadius, nearestObjects);
+		if (node.firstChild >= 0) {
+			std::array<float, 4> childDistances;
+			for (int i = 0; i < 4; i++) {
+				childDistances[i] = PointAABBDistance(position, _nodes[node.firstChild + i].quadTreeNode.rectangle);
 			}
-			if (_quadTreeChildren[2]) {
-				objectsFoundInChild = _quadTreeChildren[2]->Query(range);
-				objectsFound.insert(objectsFound.end(), objectsFoundInChild.begin(), objectsFoundInChild.end());
+			const std::array<int, 4> childOrder = OrderFurthestFirst(childDistances);
+			for (int i = 0; i < 4; i++) {
+				nodesToVisit[stackSize++] = node.firstChild + childOrder[i];
+			}
+		}
+	}
+}
+
+//Walks the nodes the ray passes through from the closest to the furthest, and skips the nodes that start after the closest hit
+template<typename T>
+inline RayHit<T> QuadTree<T>::QueryRay(Ray ray) {
+	RayHit<T> rayHit;
+	if (ray.direction.x == 0.f && ray.direction.y == 0.f) {
+		return rayHit;
+	}
+	ray.direction.normalize();
+	_stats.queries++;
+	VisitRay(_firstOutOfBounds, ray, rayHit);
+
+	std::array<int, maxDepthLimit * 3 + 1> nodesToVisit;
+	unsigned int stackSize = 0;
+	nodesToVisit[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		Node& node = _nodes[nodesToVisit[--stackSize]];
+		float distance = 0.f;
+		if (!RayAABBIntersect(ray, node.quadTreeNode.rectangle, distance) || (rayHit.objectHit && distance > rayHit.distance)) {
+			continue;
+		}
+		_stats.nodesVisited++;
+		VisitRay(node.firstStraddler, ray, rayHit);
+		VisitRay(node.firstObject, ray, rayHit);
+		if (node.firstChild >= 0) {
+			std::array<float, 4> childDistances;
+			for (int i = 0; i < 4; i++) {
+				if (!RayAABBIntersect(ray, _nodes[node.firstChild + i].quadTreeNode.rectangle, childDistances[i])) {
+					childDistances[i] = ray.length;
+				}
 			}
-			if (_quadTreeChildren[3]) {
-				objectsFoundInChild = _quadTreeChildren[3]->Query(range);
-				objectsFound.insert(objectsFound.end(), objectsFoundInChild.begin(), objectsFoundInChild.end());
+			const std::array<int, 4> childOrder = OrderFurthestFirst(childDistances);
+			for (int i = 0; i < 4; i++) {
+				nodesToVisit[stackSize++] = node.firstChild + childOrder[i];
 			}
 		}
 	}
-	return objectsFound;
+	return rayHit;
 }
+//Keeps the root node and the capacity of both vectors, so nothing is allocated when the tree is built again
 template<typename T>
 inline void QuadTree<T>::Clear() {
 	_objectsInserted.clear();
-	_circleColliders.clear();
-	_quadTreeChildren[0] = nullptr;
-	_quadTreeChildren[1] = nullptr;
-	_quadTreeChildren[2] = nullptr;
-	_quadTreeChildren[3] = nullptr;
-	_divided = false;
-}
-/*When deviding, I create 4 children that is a quarter of the size of the current node
-and sets devided to true to prevent the node from calling Subdevide more than once*/
-template<typename T>
-inline void QuadTree<T>::Subdevide() {
-	_upperLeft.rectangle =
-		AABB::makeFromPositionSize(Vector2<float>(
-			_quadTreeNode.rectangle.position.x - (_quadTreeNode.rectangle.width * 0.25f),
-			_quadTreeNode.rectangle.position.y - (_quadTreeNode.rectangle.height * 0.25f)),
-			_quadTreeNode.rectangle.height * 0.5f, _quadTreeNode.rectangle.width * 0.5f);
-	_quadTreeChildren[0] = std::make_shared<QuadTree<T>>(_upperLeft, _capacity);
-
-	_upperRight.rectangle = AABB::makeFromPositionSize(Vector2<float>(
-		_quadTreeNode.rectangle.position.x + (_quadTreeNode.rectangle.width * 0.25f),
-		_quadTreeNode.rectangle.position.y - (_quadTreeNode.rectangle.height * 0.25f)),
-		_quadTreeNode.rectangle.height * 0.5f, _quadTreeNode.rectangle.width * 0.5f);
-	_quadTreeChildren[1] = std::make_shared<QuadTree<T>>(_upperRight, _capacity);
-
-	_lowerLeft.rectangle = AABB::makeFromPositionSize(Vector2<float>(
-		_quadTreeNode.rectangle.position.x - (_quadTreeNode.rectangle.width * 0.25f),
-		_quadTreeNode.rectangle.position.y + (_quadTreeNode.rectangle.height * 0.25f)),
-		_quadTreeNode.rectangle.height * 0.5f, _quadTreeNode.rectangle.width * 0.5f);
-	_quadTreeChildren[2] = std::make_shared<QuadTree<T>>(_lowerLeft, _capacity);
-
-	_lowerRight.rectangle = AABB::makeFromPositionSize(Vector2<float>(
-		_quadTreeNode.rectangle.position.x + (_quadTreeNode.rectangle.width * 0.25f),
-		_quadTreeNode.rectangle.position.y + (_quadTreeNode.rectangle.height * 0.25f)),
-		_quadTreeNode.rectangle.height * 0.5f, _quadTreeNode.rectangle.width * 0.5f);
-	_quadTreeChildren[3] = std::make_shared<QuadTree<T>>(_lowerRight, _capacity);
-	_divided = true;
+	_nodes.clear();
+	_straddlerCount = 0;
+	_firstOutOfBounds = -1;
+	_largestOutOfBoundsRadius = 0.f;
+	_stats = QuadTreeStats();
+
+	Node root;
+	root.quadTreeNode = _quadTreeNode;
+	_nodes.emplace_back(root);
+}
+
+template<typename T>
+inline void QuadTree<T>::EndFrame() {
+	_lastFrameStats = _stats;
+	Clear();
+}
+/*When deviding, I create 4 children that is a quarter of the size of the current node.
+The children are placed next to each other at the end of the node vector, so only the index of the first child is stored*/
+template<typename T>
+inline void QuadTree<T>::Subdevide(int nodeIndex) {
+	const AABB rectangle = _nodes[nodeIndex].quadTreeNode.rectangle;
+	const unsigned int depth = _nodes[nodeIndex].depth + 1;
+	const std::array<Vector2<float>, 4> childOffsets = {
+		Vector2<float>(-0.25f, -0.25f),
+		Vector2<float>(0.25f, -0.25f),
+		Vector2<float>(-0.25f, 0.25f),
+		Vector2<float>(0.25f, 0.25f)
+	};
+
+	_nodes[nodeIndex].firstChild = _nodes.size();
+	for (unsigned int i = 0; i < childOffsets.size(); i++) {
+		Node child;
+		child.depth = depth;
+		child.quadTreeNode.rectangle = AABB::makeFromPositionSize(Vector2<float>(
+			rectangle.position.x + (rectangle.width * childOffsets[i].x),
+			rectangle.position.y + (rectangle.height * childOffsets[i].y)),
+			rectangle.height * 0.5f, rectangle.width * 0.5f);
+		_nodes.emplace_back(child);
+	}
+}
+
+template<typename T>
+inline int QuadTree<T>::AddObject(int nodeIndex, T object, Circle circleCollider) {
+	InsertedObject insertedObject;
+	insertedObject.object = object;
+	insertedObject.circleCollider = circleCollider;
+	insertedObject.nextObject = _nodes[nodeIndex].firstObject;
+	_nodes[nodeIndex].firstObject = _objectsInserted.size();
+	_nodes[nodeIndex].objectCount++;
+	_objectsInserted.emplace_back(insertedObject);
+	return _nodes[nodeIndex].firstObject;
+}
+
+template<typename T>
+inline int QuadTree<T>::AddStraddler(int nodeIndex, T object, Circle circleCollider) {
+	InsertedObject insertedObject;
+	insertedObject.object = object;
+	insertedObject.circleCollider = circleCollider;
+	insertedObject.nextObject = _nodes[nodeIndex].firstStraddler;
+	_nodes[nodeIndex].firstStraddler = _objectsInserted.size();
+	_nodes[nodeIndex].straddlerCount++;
+	if (circleCollider.radius > _nodes[nodeIndex].largestStraddlerRadius) {
+		_nodes[nodeIndex].largestStraddlerRadius = circleCollider.radius;
+	}
+	_objectsInserted.emplace_back(insertedObject);
+	_straddlerCount++;
+	_stats.straddlersPerLevel[_nodes[nodeIndex].depth]++;
+	return _nodes[nodeIndex].firstStraddler;
+}
+
+template<typename T>
+inline int QuadTree<T>::AddOutOfBounds(T object, Circle circleCollider) {
+	InsertedObject insertedObject;
+	insertedObject.object = object;
+	insertedObject.circleCollider = circleCollider;
+	insertedObject.nextObject = _firstOutOfBounds;
+	_firstOutOfBounds = _objectsInserted.size();
+	_objectsInserted.emplace_back(insertedObject);
+	if (circleCollider.radius > _largestOutOfBoundsRadius) {
+		_largestOutOfBoundsRadius = circleCollider.radius;
+	}
+	_stats.outOfBoundsInserts++;
+	return _firstOutOfBounds;
+}
+
+template<typename T>
+template<typename Range, typename Callback>
+inline bool QuadTree<T>::VisitList(int firstObject, Range range, Callback& callback) {
+	for (int i = firstObject; i >= 0; i = _objectsInserted[i].nextObject) {
+		_stats.objectsTested++;
+		if (RangeIntersect(range, _objectsInserted[i].circleCollider)) {
+			if (!callback(_objectsInserted[i].object, _objectsInserted[i].circleCollider)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+template<typename T>
+inline void QuadTree<T>::VisitNearest(int firstObject, Vector2<float> position, unsigned int k, float maxRadius,
+	std::vector<NearestObject<T>>& nearestObjects) {
+	for (int i = firstObject; i >= 0; i = _objectsInserted[i].nextObject) {
+		_stats.objectsTested++;
+		const float distance = Vector2<float>::distanceBetweenVectors(position, _objectsInserted[i].circleCollider.position);
+		if (distance <= maxRadius) {
+			AddNearestObject(nearestObjects, k, _objectsInserted[i].object, _objectsInserted[i].circleCollider, distance);
+		}
+	}
 }
+
+template<typename T>
+inline void QuadTree<T>::VisitRay(int firstObject, Ray ray, RayHit<T>& rayHit) {
+	for (int i = firstObject; i >= 0; i = _objectsInserted[i].nextObject) {
+		_stats.objectsTested++;
+		SetClosestRayHit(rayHit, ray, _objectsInserted[i].object, _objectsInserted[i].circleCollider);
+	}
+}
+
 template<typename T>
 inline void QuadTree<T>::Render() {
-	debugDrawer->AddDebugRectangle(
-		_quadTreeNode.rectangle.position, Vector2<float>(_quadTreeNode.rectangle.min.x, _quadTreeNode.rectangle.min.y),
-		Vector2<float>(_quadTreeNode.rectangle.max.x, _quadTreeNode.rectangle.max.y), { 255, 125, 0, 255});
+	for (unsigned int i = 0; i < _nodes.size(); i++) {
+		debugDrawer->AddDebugRectangle(DebugChannel::SpatialIndex,
+			_nodes[i].quadTreeNode.rectangle.position,
+			Vector2<float>(_nodes[i].quadTreeNode.rectangle.min.x, _nodes[i].quadTreeNode.rectangle.min.y),
+			Vector2<float>(_nodes[i].quadTreeNode.rectangle.max.x, _nodes[i].quadTreeNode.rectangle.max.y), { 255, 125, 0, 255 });
+	}
+}
+
+template<typename T>
+inline const unsigned int QuadTree<T>::GetNodeCount() const {
+	return _nodes.size();
+}
+
+template<typename T>
+inline const unsigned int QuadTree<T>::GetObjectCount() const {
+	return _objectsInserted.size();
+}
+
+template<typename T>
+inline const unsigned int QuadTree<T>::GetStraddlerCount() const {
+	return _straddlerCount;
+}
+
+template<typename T>
+inline const QuadTreeStats& QuadTree<T>::GetStats() const {
+	return _stats;
+}
+
+template<typename T>
+inline const QuadTreeStats& QuadTree<T>::GetLastFrameStats() const {
+	return _lastFrameStats;
+}
+
+/*A loose quadtree where every node is allocated up front and the bounds of each node are twice the size of its area.
+An object is placed in the deepest node it fits in based on its radius and position, and it keeps that node through its handle.
+Update only moves the object when its collider has left the loose bounds of the node,
+so the cost scales with the number of objects crossing between nodes instead of the number of objects.
+Objects outside the boundary are kept in the root, which every query checks, so they are never dropped*/
+template<typename T>
+class LooseQuadTree : public SpatialIndex<T> {
+public:
+	LooseQuadTree(QuadTreeNode boundary, unsigned int maxDepth = 5);
+	~LooseQuadTree();
+
+	int Insert(T object, Circle circleCollider) override;
+	int Update(int handle, T object, Circle circleCollider) override;
+	void Remove(int handle) override;
+
+	std::vector<T> Query(Circle range) override;
+	void Query(Circle range, std::vector<T>& objectsFound) override;
+	bool Query(Circle range, QueryVisitor<T>& visitor) override;
+
+	void QueryNearest(Vector2<float> position, unsigned int k, float maxRadius, std::vector<NearestObject<T>>& nearestObjects) override;
+
+	void QueryRange(AABB range, std::vector<T>& objectsFound) override;
+	bool QueryRange(AABB range, QueryVisitor<T>& visitor) override;
+
+	RayHit<T> QueryRay(Ray ray) override;
+
+	template<typename Range, typename Callback>
+	bool ForEachInRange(Range range, Callback&& callback);
+
+	void Clear() override;
+	void EndFrame() override;
+
+	void Render() override;
+
+	const unsigned int GetObjectCount() const;
+	const unsigned int GetRelocationCount() const;
+
+	static constexpr unsigned int maxDepthLimit = 8;
+
+private:
+	struct Node {
+		QuadTreeNode quadTreeNode;
+		AABB looseRectangle;
+		int firstObject = -1;
+		unsigned int objectCount = 0;
+		//Objects in this node and all nodes below it, used to skip empty branches when querying
+		unsigned int subtreeCount = 0;
+		unsigned int depth = 0;
+		unsigned int cellX = 0;
+		unsigned int cellY = 0;
+	};
+
+	struct InsertedObject {
+		T object;
+		Circle circleCollider;
+		int node = -1;
+		int previousObject = -1;
+		int nextObject = -1;
+	};
+
+	int FindNode(Circle circleCollider);
+	bool FitsInNode(int nodeIndex, Circle circleCollider);
+	const int GetNodeIndex(unsigned int depth, unsigned int cellX, unsigned int cellY) const;
+
+	void LinkObject(int objectIndex, int nodeIndex);
+	void UnlinkObject(int objectIndex);
+
+	unsigned int _maxDepth = 0;
+	unsigned int _objectCount = 0;
+	unsigned int _relocationCount = 0;
+	int _firstFreeObject = -1;
 
-	for (unsigned int i = 0; i < _quadTreeChildren.size(); i++) {
-		if (_quadTreeChildren[i]) {
-			_quadTreeChildren[i]->Render();
+	QuadTreeNode _quadTreeNode;
+
+	std::vector<Node> _nodes;
+	std::vector<InsertedObject> _objectsInserted;
+};
+
+template<typename T>
+inline LooseQuadTree<T>::LooseQuadTree(QuadTreeNode boundary, unsigned int maxDepth) {
+	_quadTreeNode = boundary;
+	_maxDepth = maxDepth < maxDepthLimit ? maxDepth : maxDepthLimit;
+
+	//Every level has 4 times as many nodes as the level above, and they are all created here
+	const AABB rectangle = boundary.rectangle;
+	for (unsigned int depth = 0; depth <= _maxDepth; depth++) {
+		const unsigned int cellsPerSide = 1 << depth;
+		const float cellWidth = rectangle.width / cellsPerSide;
+		const float cellHeight = rectangle.height / cellsPerSide;
+		for (unsigned int y = 0; y < cellsPerSide; y++) {
+			for (unsigned int x = 0; x < cellsPerSide; x++) {
+				Node node;
+				node.depth = depth;
+				node.cellX = x;
+				node.cellY = y;
+				node.quadTreeNode.rectangle = AABB::makeFromPositionSize(Vector2<float>(
+					rectangle.min.x + cellWidth * (x + 0.5f),
+					rectangle.min.y + cellHeight * (y + 0.5f)),
+					cellHeight, cellWidth);
+				node.looseRectangle = AABB::makeFromPositionSize(
+					node.quadTreeNode.rectangle.position, cellHeight * 2.f, cellWidth * 2.f);
+				_nodes.emplace_back(node);
+			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+template<typename T>
+inline LooseQuadTree<T>::~LooseQuadTree() {
+	Clear();
+}
+
+template<typename T>
+inline int LooseQuadTree<T>::Insert(T object, Circle circleCollider) {
+	//Reuses the slot of a removed object if there is one, so the handles of the other objects never change
+	int objectIndex = _firstFreeObject;
+	if (objectIndex >= 0) {
+		_firstFreeObject = _objectsInserted[objectIndex].nextObject;
+	} else {
+		objectIndex = _objectsInserted.size();
+		_objectsInserted.emplace_back(InsertedObject());
+	}
+	_objectsInserted[objectIndex].object = object;
+	_objectsInserted[objectIndex].circleCollider = circleCollider;
+	LinkObject(objectIndex, FindNode(circleCollider));
+	_objectCount++;
+	return objectIndex;
+}
+
+template<typename T>
+inline int LooseQuadTree<T>::Update(int handle, T object, Circle circleCollider) {
+	if (handle < 0 || handle >= (int)_objectsInserted.size() || _objectsInserted[handle].node < 0) {
+		return Insert(object, circleCollider);
+	}
+	_objectsInserted[handle].object = object;
+	_objectsInserted[handle].circleCollider = circleCollider;
+	//Only moves the object if it has left the loose bounds of the node it's in
+	if (FitsInNode(_objectsInserted[handle].node, circleCollider)) {
+		return handle;
+	}
+	UnlinkObject(handle);
+	LinkObject(handle, FindNode(circleCollider));
+	_relocationCount++;
+	return handle;
+}
+
+template<typename T>
+inline void LooseQuadTree<T>::Remove(int handle) {
+	if (handle < 0 || handle >= (int)_objectsInserted.size() || _objectsInserted[handle].node < 0) {
+		return;
+	}
+	UnlinkObject(handle);
+	_objectsInserted[handle].object = T();
+	_objectsInserted[handle].nextObject = _firstFreeObject;
+	_firstFreeObject = handle;
+	_objectCount--;
+}
+
+template<typename T>
+inline std::vector<T> LooseQuadTree<T>::Query(Circle range) {
+	std::vector<T> objectsFound;
+	Query(range, objectsFound);
+	return objectsFound;
+}
+
+template<typename T>
+inline void LooseQuadTree<T>::Query(Circle range, std::vector<T>& objectsFound) {
+	objectsFound.clear();
+	ForEachInRange(range, [&objectsFound](const T& object, const Circle& circleCollider) {
+		objectsFound.emplace_back(object);
+		return true;
+	});
+}
+
+template<typename T>
+inline bool LooseQuadTree<T>::Query(Circle range, QueryVisitor<T>& visitor) {
+	return ForEachInRange(range, [&visitor](const T& object, const Circle& circleCollider) {
+		return visitor.Visit(object, circleCollider);
+	});
+}
+
+template<typename T>
+inline void LooseQuadTree<T>::QueryRange(AABB range, std::vector<T>& objectsFound) {
+	objectsFound.clear();
+	ForEachInRange(range, [&objectsFound](const T& object, const Circle& circleCollider) {
+		objectsFound.emplace_back(object);
+		return true;
+	});
+}
+
+template<typename T>
+inline bool LooseQuadTree<T>::QueryRange(AABB range, QueryVisitor<T>& visitor) {
+	return ForEachInRange(range, [&visitor](const T& object, const Circle& circleCollider) {
+		return visitor.Visit(object, circleCollider);
+	});
+}
+
+template<typename T>
+template<typename Range, typename Callback>
+inline bool LooseQuadTree<T>::ForEachInRange(Range range, Callback&& callback) {
+	std::array<int, maxDepthLimit * 3 + 1> nodesToVisit;
+	unsigned int stackSize = 0;
+	nodesToVisit[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		Node& node = _nodes[nodesToVisit[--stackSize]];
+		//The root also holds the objects that are too big for any other node or outside the boundary, so it's always checked
+		if (node.subtreeCount == 0 || (node.depth > 0 && !RangeIntersect(range, node.looseRectangle))) {
+			continue;
+		}
+		for (int i = node.firstObject; i >= 0; i = _objectsInserted[i].nextObject) {
+			if (RangeIntersect(range, _objectsInserted[i].circleCollider)) {
+				if (!callback(_objectsInserted[i].object, _objectsInserted[i].circleCollider)) {
+					return false;
+				}
+			}
+		}
+		if (node.depth < _maxDepth) {
+			for (unsigned int y = 0; y < 2; y++) {
+				for (unsigned int x = 0; x < 2; x++) {
+					nodesToVisit[stackSize++] = GetNodeIndex(node.depth + 1, node.cellX * 2 + x, node.cellY * 2 + y);
+				}
+			}
+		}
+	}
+	return true;
+}
+
+//Every object below the root is fully inside the loose bounds of its node, so the loose bounds are used to skip nodes
+template<typename T>
+inline void LooseQuadTree<T>::QueryNearest(Vector2<float> position, unsigned int k, float maxRadius, std::vector<NearestObject<T>>& nearestObjects) {
+	nearestObjects.clear();
+	std::array<int, maxDepthLimit * 3 + 1> nodesToVisit;
+	unsigned int stackSize = 0;
+	nodesToVisit[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		Node& node = _nodes[nodesToVisit[--stackSize]];
+		if (node.subtreeCount == 0 ||
+			(node.depth > 0 && PointAABBDistance(position, node.looseRectangle) > NearestCutoff(nearestObjects, k, maxRadius))) {
+			continue;
+		}
+		for (int i = node.firstObject; i >= 0; i = _objectsInserted[i].nextObject) {
+			const float distance = Vector2<float>::distanceBetweenVectors(position, _objectsInserted[i].circleCollider.position);
+			if (distance <= maxRadius) {
+				AddNearestObject(nearestObjects, k, _objectsInserted[i].object, _objectsInserted[i].circleCollider, distance);
+			}
+		}
+		if (node.depth < _maxDepth) {
+			std::array<int, 4> children;
+			std::array<float, 4> childDistances;
+			for (unsigned int i = 0; i < 4; i++) {
+				children[i] = GetNodeIndex(node.depth + 1, node.cellX * 2 + (i % 2), node.cellY * 2 + (i / 2));
+				childDistances[i] = PointAABBDistance(position, _nodes[children[i]].looseRectangle);
+			}
+			const std::array<int, 4> childOrder = OrderFurthestFirst(childDistances);
+			for (int i = 0; i < 4; i++) {
+				nodesToVisit[stackSize++] = children[childOrder[i]];
+			}
+		}
+	}
+}
+
+template<typename T>
+inline RayHit<T> LooseQuadTree<T>::QueryRay(Ray ray) {
+	RayHit<T> rayHit;
+	if (ray.direction.x == 0.f && ray.direction.y == 0.f) {
+		return rayHit;
+	}
+	ray.direction.normalize();
+	std::array<int, maxDepthLimit * 3 + 1> nodesToVisit;
+	unsigned int stackSize = 0;
+	nodesToVisit[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		Node& node = _nodes[nodesToVisit[--stackSize]];
+		if (node.subtreeCount == 0) {
+			continue;
+		}
+		float distance = 0.f;
+		if (node.depth > 0 &&
+			(!RayAABBIntersect(ray, node.looseRectangle, distance) || (rayHit.objectHit && distance > rayHit.distance))) {
+			continue;
+		}
+		for (int i = node.firstObject; i >= 0; i = _objectsInserted[i].nextObject) {
+			SetClosestRayHit(rayHit, ray, _objectsInserted[i].object, _objectsInserted[i].circleCollider);
+		}
+		if (node.depth < _maxDepth) {
+			std::array<int, 4> children;
+			std::array<float, 4> childDistances;
+			for (unsigned int i = 0; i < 4; i++) {
+				children[i] = GetNodeIndex(node.depth + 1, node.cellX * 2 + (i % 2), node.cellY * 2 + (i / 2));
+				if (!RayAABBIntersect(ray, _nodes[children[i]].looseRectangle, childDistances[i])) {
+					childDistances[i] = ray.length;
+				}
+			}
+			const std::array<int, 4> childOrder = OrderFurthestFirst(childDistances);
+			for (int i = 0; i < 4; i++) {
+				nodesToVisit[stackSize++] = children[childOrder[i]];
+			}
+		}
+	}
+	return rayHit;
+}
+
+template<typename T>
+inline void LooseQuadTree<T>::Clear() {
+	for (unsigned int i = 0; i < _nodes.size(); i++) {
+		_nodes[i].firstObject = -1;
+		_nodes[i].objectCount = 0;
+		_nodes[i].subtreeCount = 0;
+	}
+	_objectsInserted.clear();
+	_firstFreeObject = -1;
+	_objectCount = 0;
+}
+//Objects are kept between frames and moved by Update instead
+template<typename T>
+inline void LooseQuadTree<T>::EndFrame() {
+	_relocationCount = 0;
+}
+
+template<typename T>
+inline void LooseQuadTree<T>::Render() {
+	for (unsigned int i = 0; i < _nodes.size(); i++) {
+		if (_nodes[i].objectCount == 0) {
+			continue;
+		}
+		debugDrawer->AddDebugRectangle(DebugChannel::SpatialIndex,
+			_nodes[i].quadTreeNode.rectangle.position, _nodes[i].quadTreeNode.rectangle.min,
+			_nodes[i].quadTreeNode.rectangle.max, { 255, 125, 0, 255 });
+	}
+}
+
+template<typename T>
+inline const unsigned int LooseQuadTree<T>::GetObjectCount() const {
+	return _objectCount;
+}
+
+template<typename T>
+inline const unsigned int LooseQuadTree<T>::GetRelocationCount() const {
+	return _relocationCount;
+}
+/*Picks the deepest level where the collider is no bigger than half a node,
+which guarantees that it fits inside the loose bounds of the node its center is in. Colliders with their center outside the boundary go in the root*/
+template<typename T>
+inline int LooseQuadTree<T>::FindNode(Circle circleCollider) {
+	const AABB& rectangle = _quadTreeNode.rectangle;
+	const float smallestSide = rectangle.width < rectangle.height ? rectangle.width : rectangle.height;
+	if (circleCollider.position.x < rectangle.min.x || circleCollider.position.x > rectangle.max.x ||
+		circleCollider.position.y < rectangle.min.y || circleCollider.position.y > rectangle.max.y ||
+		circleCollider.radius * 2.f > smallestSide) {
+		return 0;
+	}
+	unsigned int depth = 0;
+	while (depth < _maxDepth && circleCollider.radius * 2.f <= smallestSide / (1 << (depth + 1))) {
+		depth++;
+	}
+	const unsigned int cellsPerSide = 1 << depth;
+	unsigned int cellX = (unsigned int)((circleCollider.position.x - rectangle.min.x) / rectangle.width * cellsPerSide);
+	unsigned int cellY = (unsigned int)((circleCollider.position.y - rectangle.min.y) / rectangle.height * cellsPerSide);
+	cellX = cellX < cellsPerSide ? cellX : cellsPerSide - 1;
+	cellY = cellY < cellsPerSide ? cellY : cellsPerSide - 1;
+	return GetNodeIndex(depth, cellX, cellY);
+}
+
+template<typename T>
+inline bool LooseQuadTree<T>::FitsInNode(int nodeIndex, Circle circleCollider) {
+	if (nodeIndex == 0) {
+		//Objects in the root might fit further down now
+		return FindNode(circleCollider) == 0;
+	}
+	const AABB& looseRectangle = _nodes[nodeIndex].looseRectangle;
+	return circleCollider.position.x - circleCollider.radius >= looseRectangle.min.x &&
+		circleCollider.position.x + circleCollider.radius <= looseRectangle.max.x &&
+		circleCollider.position.y - circleCollider.radius >= looseRectangle.min.y &&
+		circleCollider.position.y + circleCollider.radius <= looseRectangle.max.y;
+}
+//The nodes are stored level by level, and a level starts after the (4^depth - 1) / 3 nodes above it
+template<typename T>
+inline const int LooseQuadTree<T>::GetNodeIndex(unsigned int depth, unsigned int cellX, unsigned int cellY) const {
+	return (int)((((1u << (depth * 2)) - 1) / 3) + cellY * (1u << depth) + cellX);
+}
+
+template<typename T>
+inline void LooseQuadTree<T>::LinkObject(int objectIndex, int nodeIndex) {
+	Node& node = _nodes[nodeIndex];
+	InsertedObject& insertedObject = _objectsInserted[objectIndex];
+	insertedObject.node = nodeIndex;
+	insertedObject.previousObject = -1;
+	insertedObject.nextObject = node.firstObject;
+	if (node.firstObject >= 0) {
+		_objectsInserted[node.firstObject].previousObject = objectIndex;
+	}
+	node.firstObject = objectIndex;
+	node.objectCount++;
+
+	//Walks up through the parents so they know there is something below them
+	unsigned int depth = node.depth;
+	unsigned int cellX = node.cellX;
+	unsigned int cellY = node.cellY;
+	while (true) {
+		_nodes[GetNodeIndex(depth, cellX, cellY)].subtreeCount++;
+		if (depth == 0) {
+			break;
+		}
+		depth--;
+		cellX /= 2;
+		cellY /= 2;
+	}
+}
+
+template<typename T>
+inline void LooseQuadTree<T>::UnlinkObject(int objectIndex) {
+	InsertedObject& insertedObject = _objectsInserted[objectIndex];
+	Node& node = _nodes[insertedObject.node];
+	if (insertedObject.previousObject >= 0) {
+		_objectsInserted[insertedObject.previousObject].nextObject = insertedObject.nextObject;
+	} else {
+		node.firstObject = insertedObject.nextObject;
+	}
+	if (insertedObject.nextObject >= 0) {
+		_objectsInserted[insertedObject.nextObject].previousObject = insertedObject.previousObject;
+	}
+	node.objectCount--;
+
+	unsigned int depth = node.depth;
+	unsigned int cellX = node.cellX;
+	unsigned int cellY = node.cellY;
+	while (true) {
+		_nodes[GetNodeIndex(depth, cellX, cellY)].subtreeCount--;
+		if (depth == 0) {
+			break;
+		}
+		depth--;
+		cellX /= 2;
+		cellY /= 2;
+	}
+	insertedObject.node = -1;
+	insertedObject.previousObject = -1;
+	insertedObject.nextObject = -1;
+}
@@ -0,0 +1,88 @@
+#include "rotatedSprite.h"
+#include "gameEngine.h"
+#include "spriteBatcher.h"
+
+#include <cmath>
+
+bool RotatedSprite::Build(SDL_Renderer* renderer, SDL_Texture* sourceTexture, SDL_Rect firstFrame, int frames, int angles, int maxTextureSize) {
+	Destroy();
+	if (!renderer || !sourceTexture || frames <= 0 || angles <= 0 || !SDL_RenderTargetSupported(renderer)) {
+		return false;
+	}
+	//A pixel of space around every rotation, so they don't bleed into each other if the texture is ever filtered
+	cellSize = (int)ceilf(sqrtf((float)(firstFrame.w * firstFrame.w + firstFrame.h * firstFrame.h))) + 2;
+	const int cellCount = frames * angles;
+	columns = maxTextureSize / cellSize;
+	if (columns > cellCount) {
+		columns = cellCount;
+	}
+	if (columns <= 0 || ((cellCount + columns - 1) / columns) * cellSize > maxTextureSize) {
+		return false;
+	}
+	textureWidth = columns * cellSize;
+	textureHeight = ((cellCount + columns - 1) / columns) * cellSize;
+	texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, textureWidth, textureHeight);
+	if (!texture) {
+		return false;
+	}
+	frameCount = frames;
+	angleCount = angles;
+
+	//Whatever the renderer was doing is put back afterwards, since sprites can be loaded in the middle of a frame
+	SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+	SDL_BlendMode previousBlendMode;
+	SDL_GetTextureBlendMode(sourceTexture, &previousBlendMode);
+	Uint8 r, g, b, a;
+	SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+
+	SDL_SetRenderTarget(renderer, texture);
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+	SDL_RenderClear(renderer);
+	//Copied as it is, blending it with the cleared texture would darken the edges of the sprite
+	SDL_SetTextureBlendMode(sourceTexture, SDL_BLENDMODE_NONE);
+	for (int frame = 0; frame < frames; frame++) {
+		SDL_Rect source = { firstFrame.x + frame * firstFrame.w, firstFrame.y, firstFrame.w, firstFrame.h };
+		for (int angle = 0; angle < angles; angle++) {
+			const int cell = frame * angles + angle;
+			SDL_Rect destination = { (cell % columns) * cellSize + (cellSize - firstFrame.w) / 2, (cell / columns) * cellSize + (cellSize - firstFrame.h) / 2,
+				firstFrame.w, firstFrame.h };
+			SDL_RenderCopyEx(renderer, sourceTexture, &source, &destination, angle * 360.0 / angles, NULL, SDL_FLIP_NONE);
+		}
+	}
+	SDL_SetTextureBlendMode(sourceTexture, previousBlendMode);
+	SDL_SetRenderTarget(renderer, previousTarget);
+	SDL_SetRenderDrawColor(renderer, r, g, b, a);
+	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+	return true;
+}
+
+void RotatedSprite::Destroy() {
+	if (texture) {
+		SDL_DestroyTexture(texture);
+	}
+	texture = nullptr;
+	textureWidth = 0;
+	textureHeight = 0;
+	cellSize = 0;
+	columns = 0;
+	frameCount = 0;
+	angleCount = 0;
+}
+
+SDL_Rect RotatedSprite::GetCell(int frame, float orientation) const {
+	//The orientation can be any number of turns in either direction
+	const float turns = orientation / (2.f * (float)PI);
+	const int angle = (int)floorf((turns - floorf(turns)) * angleCount + 0.5f) % angleCount;
+	const int cell = frame * angleCount + angle;
+	return { (cell % columns) * cellSize, (cell / columns) * cellSize, cellSize, cellSize };
+}
+
+void RotatedSprite::RenderCentered(int frame, Vector2<float> position, float orientation) {
+	SDL_Rect source = GetCell(frame, orientation);
+	if (spriteBatcher && spriteBatcher->IsBatching()) {
+		spriteBatcher->Draw(texture, textureWidth, textureHeight, source, { position.x - cellSize * 0.5f, position.y - cellSize * 0.5f, (float)cellSize, (float)cellSize }, 0.f);
+		return;
+	}
+	SDL_Rect destination = { (int)position.x - cellSize / 2, (int)position.y - cellSize / 2, cellSize, cellSize };
+	SDL_RenderCopy(renderer, texture, &source, &destination);
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include "vector2.h"
+
+/*Every frame of a sprite drawn once at angleCount evenly spread angles, all in one texture, when the sprite is loaded.
+Without a GPU SDL_RenderCopyEx rotates every pixel of the sprite each time it's drawn, this way drawing a rotated sprite is a plain copy
+of whichever angle is closest. Every cell is as big as the diagonal of the frame so no rotation is cut off*/
+struct RotatedSprite {
+	//Draws the frames with the given renderer, the frames are next to each other from firstFrame. Returns false if the renderer can't render to a texture
+	bool Build(SDL_Renderer* renderer, SDL_Texture* sourceTexture, SDL_Rect firstFrame, int frames, int angles, int maxTextureSize = 4096);
+	void Destroy();
+
+	//The cell with the angle closest to the orientation, which is in radians
+	SDL_Rect GetCell(int frame, float orientation) const;
+	//Goes through the sprite batcher while it's batching
+	void RenderCentered(int frame, Vector2<float> position, float orientation);
+
+	SDL_Texture* texture = nullptr;
+	int textureWidth = 0;
+	int textureHeight = 0;
+	int cellSize = 0;
+	int columns = 0;
+	int frameCount = 0;
+	int angleCount = 0;
+};
@@ -0,0 +1 @@
+#include "slabPool.h"
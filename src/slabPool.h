@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/*Constructs the objects in place inside big slabs instead of giving each of them an allocation of its own,
+so objects that are created one after another also sit next to each other in memory.
+A full slab is never grown, a new one is started instead, so an object never moves once it has been constructed.
+The shared pointers handed out share the ownership of the slab the object is in, that way the rest of the game can keep using shared pointers
+and the slab with all its objects is destroyed once the last one of them is let go*/
+template<typename T>
+class SlabPool {
+public:
+	SlabPool(unsigned int objectsPerSlab);
+	~SlabPool() {}
+
+	template<typename... Args>
+	T* Construct(Args&&... args);
+	template<typename... Args>
+	std::shared_ptr<T> MakeShared(Args&&... args);
+
+	unsigned int ObjectCount() const;
+	unsigned int SlabCount() const;
+
+	//The slabs start on a cache line of their own, so two pools never share one
+	static constexpr std::size_t cacheLineSize = 64;
+
+private:
+	struct Slab {
+		Slab(unsigned int capacity);
+		~Slab();
+
+		T* objects = nullptr;
+		unsigned int capacity = 0;
+		unsigned int size = 0;
+	};
+
+	std::vector<std::shared_ptr<Slab>> _slabs;
+
+	unsigned int _objectsPerSlab = 0;
+	unsigned int _objectCount = 0;
+};
+
+template<typename T>
+inline SlabPool<T>::Slab::Slab(unsigned int capacity) : capacity(capacity) {
+	const std::size_t alignment = alignof(T) > cacheLineSize ? alignof(T) : cacheLineSize;
+	objects = static_cast<T*>(::operator new(sizeof(T) * capacity, std::align_val_t(alignment)));
+}
+
+template<typename T>
+inline SlabPool<T>::Slab::~Slab() {
+	for (unsigned int i = 0; i < size; i++) {
+		objects[i].~T();
+	}
+	const std::size_t alignment = alignof(T) > cacheLineSize ? alignof(T) : cacheLineSize;
+	::operator delete(objects, std::align_val_t(alignment));
+}
+
+template<typename T>
+inline SlabPool<T>::SlabPool(unsigned int objectsPerSlab) {
+	_objectsPerSlab = objectsPerSlab > 0 ? objectsPerSlab : 1;
+}
+
+template<typename T>
+template<typename... Args>
+inline T* SlabPool<T>::Construct(Args&&... args) {
+	return MakeShared(std::forward<Args>(args)...).get();
+}
+
+template<typename T>
+template<typename... Args>
+inline std::shared_ptr<T> SlabPool<T>::MakeShared(Args&&... args) {
+	if (_slabs.empty() || _slabs.back()->size == _slabs.back()->capacity) {
+		_slabs.emplace_back(std::make_shared<Slab>(_objectsPerSlab));
+	}
+	Slab& slab = *_slabs.back();
+	T* object = new (slab.objects + slab.size) T(std::forward<Args>(args)...);
+	//Only counted once it's constructed, so the slab doesn't destroy an object that threw in its constructor
+	slab.size++;
+	_objectCount++;
+	return std::shared_ptr<T>(_slabs.back(), object);
+}
+
+template<typename T>
+inline unsigned int SlabPool<T>::ObjectCount() const {
+	return _objectCount;
+}
+
+template<typename T>
+inline unsigned int SlabPool<T>::SlabCount() const {
+	return _slabs.size();
+}
@@ -0,0 +1 @@
+#include "spatialHashGrid.h"
@@ -0,0 +1,395 @@
+#pragma once
+#include "collision.h"
+#include "spatialIndex.h"
+#include "vector2.h"
+
+#include <cfloat>
+#include <vector>
+
+#include "debugDrawer.h"
+#include "gameEngine.h"
+
+/*A uniform grid over the arena. Since the arena has fixed bounds the cell coordinates are used directly as the hash,
+so every cell has its own slot and there are no collisions between cells.
+Every object is stored in the cell its center is in, the query grows its range by the largest radius inserted
+so objects that only overlap a cell with their edge are still found.
+Objects outside the arena are stored in the closest border cell instead of being dropped*/
+template<typename T>
+class SpatialHashGrid : public SpatialIndex<T> {
+public:
+	SpatialHashGrid(AABB boundary, float cellSize);
+	~SpatialHashGrid();
+
+	int Insert(T object, Circle circleCollider) override;
+	int Update(int handle, T object, Circle circleCollider) override;
+	void Remove(int handle) override;
+
+	std::vector<T> Query(Circle range) override;
+	void Query(Circle range, std::vector<T>& objectsFound) override;
+	bool Query(Circle range, QueryVisitor<T>& visitor) override;
+
+	void QueryNearest(Vector2<float> position, unsigned int k, float maxRadius, std::vector<NearestObject<T>>& nearestObjects) override;
+
+	void QueryRange(AABB range, std::vector<T>& objectsFound) override;
+	bool QueryRange(AABB range, QueryVisitor<T>& visitor) override;
+
+	RayHit<T> QueryRay(Ray ray) override;
+
+	template<typename Range, typename Callback>
+	bool ForEachInRange(Range range, Callback&& callback);
+
+	void Clear() override;
+	void EndFrame() override;
+
+	void Render() override;
+
+	const unsigned int GetObjectCount() const;
+	const unsigned int GetCellCount() const;
+
+private:
+	struct Cell {
+		int firstObject = -1;
+		unsigned int objectCount = 0;
+	};
+
+	struct InsertedObject {
+		T object;
+		Circle circleCollider;
+		int cell = -1;
+		int previousObject = -1;
+		int nextObject = -1;
+	};
+
+	const int GetCellX(float positionX) const;
+	const int GetCellY(float positionY) const;
+	const int GetCellIndex(Vector2<float> position) const;
+	//The border cells also hold the objects outside the arena, so their bounds are stretched out to cover them
+	const AABB GetCellBounds(int cellX, int cellY, float margin) const;
+
+	void LinkObject(int objectIndex, int cellIndex);
+	void UnlinkObject(int objectIndex);
+
+	AABB _boundary;
+	float _cellSize = 0.f;
+	float _largestRadius = 0.f;
+	int _cellsX = 0;
+	int _cellsY = 0;
+
+	unsigned int _objectCount = 0;
+	int _firstFreeObject = -1;
+
+	std::vector<Cell> _cells;
+	std::vector<InsertedObject> _objectsInserted;
+};
+
+template<typename T>
+inline SpatialHashGrid<T>::SpatialHashGrid(AABB boundary, float cellSize) {
+	_boundary = boundary;
+	_cellSize = cellSize > 1.f ? cellSize : 1.f;
+	_cellsX = (int)((boundary.width + _cellSize - 1.f) / _cellSize);
+	_cellsY = (int)((boundary.height + _cellSize - 1.f) / _cellSize);
+	_cellsX = _cellsX > 0 ? _cellsX : 1;
+	_cellsY = _cellsY > 0 ? _cellsY : 1;
+	_cells.resize(_cellsX * _cellsY);
+}
+
+template<typename T>
+inline SpatialHashGrid<T>::~SpatialHashGrid() {
+	_cells.clear();
+	_objectsInserted.clear();
+}
+
+template<typename T>
+inline int SpatialHashGrid<T>::Insert(T object, Circle circleCollider) {
+	int objectIndex = -1;
+	if (_firstFreeObject >= 0) {
+		objectIndex = _firstFreeObject;
+		_firstFreeObject = _objectsInserted[objectIndex].nextObject;
+	} else {
+		objectIndex = (int)_objectsInserted.size();
+		_objectsInserted.emplace_back();
+	}
+	_objectsInserted[objectIndex].object = object;
+	_objectsInserted[objectIndex].circleCollider = circleCollider;
+	LinkObject(objectIndex, GetCellIndex(circleCollider.position));
+	if (circleCollider.radius > _largestRadius) {
+		_largestRadius = circleCollider.radius;
+	}
+	_objectCount++;
+	return objectIndex;
+}
+
+//Only relinks the object if its center has moved to another cell
+template<typename T>
+inline int SpatialHashGrid<T>::Update(int handle, T object, Circle circleCollider) {
+	if (handle < 0 || handle >= (int)_objectsInserted.size() || _objectsInserted[handle].cell < 0) {
+		return Insert(object, circleCollider);
+	}
+	InsertedObject& insertedObject = _objectsInserted[handle];
+	insertedObject.object = object;
+	insertedObject.circleCollider = circleCollider;
+	if (circleCollider.radius > _largestRadius) {
+		_largestRadius = circleCollider.radius;
+	}
+	const int cellIndex = GetCellIndex(circleCollider.position);
+	if (cellIndex != insertedObject.cell) {
+		UnlinkObject(handle);
+		LinkObject(handle, cellIndex);
+	}
+	return handle;
+}
+
+template<typename T>
+inline void SpatialHashGrid<T>::Remove(int handle) {
+	if (handle < 0 || handle >= (int)_objectsInserted.size() || _objectsInserted[handle].cell < 0) {
+		return;
+	}
+	UnlinkObject(handle);
+	_objectsInserted[handle].object = T();
+	_objectsInserted[handle].nextObject = _firstFreeObject;
+	_firstFreeObject = handle;
+	_objectCount--;
+}
+
+template<typename T>
+inline std::vector<T> SpatialHashGrid<T>::Query(Circle range) {
+	std::vector<T> objectsFound;
+	Query(range, objectsFound);
+	return objectsFound;
+}
+
+template<typename T>
+inline void SpatialHashGrid<T>::Query(Circle range, std::vector<T>& objectsFound) {
+	objectsFound.clear();
+	ForEachInRange(range, [&objectsFound](const T& object, const Circle& circleCollider) {
+		objectsFound.emplace_back(object);
+		return true;
+	});
+}
+
+template<typename T>
+inline bool SpatialHashGrid<T>::Query(Circle range, QueryVisitor<T>& visitor) {
+	return ForEachInRange(range, [&visitor](const T& object, const Circle& circleCollider) {
+		return visitor.Visit(object, circleCollider);
+	});
+}
+
+template<typename T>
+inline void SpatialHashGrid<T>::QueryRange(AABB range, std::vector<T>& objectsFound) {
+	objectsFound.clear();
+	ForEachInRange(range, [&objectsFound](const T& object, const Circle& circleCollider) {
+		objectsFound.emplace_back(object);
+		return true;
+	});
+}
+
+template<typename T>
+inline bool SpatialHashGrid<T>::QueryRange(AABB range, QueryVisitor<T>& visitor) {
+	return ForEachInRange(range, [&visitor](const T& object, const Circle& circleCollider) {
+		return visitor.Visit(object, circleCollider);
+	});
+}
+
+template<typename T>
+template<typename Range, typename Callback>
+inline bool SpatialHashGrid<T>::ForEachInRange(Range range, Callback&& callback) {
+	const AABB bounds = RangeBounds(range);
+	const int minX = GetCellX(bounds.min.x - _largestRadius);
+	const int maxX = GetCellX(bounds.max.x + _largestRadius);
+	const int minY = GetCellY(bounds.min.y - _largestRadius);
+	const int maxY = GetCellY(bounds.max.y + _largestRadius);
+
+	for (int y = minY; y <= maxY; y++) {
+		for (int x = minX; x <= maxX; x++) {
+			const Cell& cell = _cells[y * _cellsX + x];
+			for (int i = cell.firstObject; i >= 0; i = _objectsInserted[i].nextObject) {
+				if (RangeIntersect(range, _objectsInserted[i].circleCollider)) {
+					if (!callback(_objectsInserted[i].object, _objectsInserted[i].circleCollider)) {
+						return false;
+					}
+				}
+			}
+		}
+	}
+	return true;
+}
+
+/*Walks outwards from the cell the position is in one ring of cells at a time.
+Once k objects have been found, the search stops at the first ring that is further away than the furthest of them*/
+template<typename T>
+inline void SpatialHashGrid<T>::QueryNearest(Vector2<float> position, unsigned int k, float maxRadius, std::vector<NearestObject<T>>& nearestObjects) {
+	nearestObjects.clear();
+	const int centerX = GetCellX(position.x);
+	const int centerY = GetCellY(position.y);
+	const int maxRing = _cellsX > _cellsY ? _cellsX : _cellsY;
+
+	for (int ring = 0; ring < maxRing; ring++) {
+		if ((ring - 1) * _cellSize > NearestCutoff(nearestObjects, k, maxRadius)) {
+			break;
+		}
+		for (int y = centerY - ring; y <= centerY + ring; y++) {
+			if (y < 0 || y >= _cellsY) {
+				continue;
+			}
+			//Only the cells on the edge of the ring are new, the ones inside it were checked by the earlier rings
+			const int stepX = (y == centerY - ring || y == centerY + ring) ? 1 : ring * 2;
+			for (int x = centerX - ring; x <= centerX + ring; x += stepX) {
+				if (x < 0 || x >= _cellsX) {
+					continue;
+				}
+				AABB cellBounds = GetCellBounds(x, y, 0.f);
+				if (PointAABBDistance(position, cellBounds) > NearestCutoff(nearestObjects, k, maxRadius)) {
+					continue;
+				}
+				for (int i = _cells[y * _cellsX + x].firstObject; i >= 0; i = _objectsInserted[i].nextObject) {
+					const float distance = Vector2<float>::distanceBetweenVectors(position, _objectsInserted[i].circleCollider.position);
+					if (distance <= maxRadius) {
+						AddNearestObject(nearestObjects, k, _objectsInserted[i].object, _objectsInserted[i].circleCollider, distance);
+					}
+				}
+			}
+		}
+	}
+}
+
+//Checks the cells around the ray, cells that start after the closest hit so far are skipped
+template<typename T>
+inline RayHit<T> SpatialHashGrid<T>::QueryRay(Ray ray) {
+	RayHit<T> rayHit;
+	if (ray.direction.x == 0.f && ray.direction.y == 0.f) {
+		return rayHit;
+	}
+	ray.direction.normalize();
+	const Vector2<float> rayEnd = ray.startPosition + ray.direction * ray.length;
+	const int minX = GetCellX((ray.startPosition.x < rayEnd.x ? ray.startPosition.x : rayEnd.x) - _largestRadius);
+	const int maxX = GetCellX((ray.startPosition.x > rayEnd.x ? ray.startPosition.x : rayEnd.x) + _largestRadius);
+	const int minY = GetCellY((ray.startPosition.y < rayEnd.y ? ray.startPosition.y : rayEnd.y) - _largestRadius);
+	const int maxY = GetCellY((ray.startPosition.y > rayEnd.y ? ray.startPosition.y : rayEnd.y) + _largestRadius);
+
+	for (int y = minY; y <= maxY; y++) {
+		for (int x = minX; x <= maxX; x++) {
+			const Cell& cell = _cells[y * _cellsX + x];
+			if (cell.firstObject < 0) {
+				continue;
+			}
+			AABB cellBounds = GetCellBounds(x, y, _largestRadius);
+			float distance = 0.f;
+			if (!RayAABBIntersect(ray, cellBounds, distance) || (rayHit.objectHit && distance > rayHit.distance)) {
+				continue;
+			}
+			for (int i = cell.firstObject; i >= 0; i = _objectsInserted[i].nextObject) {
+				SetClosestRayHit(rayHit, ray, _objectsInserted[i].object, _objectsInserted[i].circleCollider);
+			}
+		}
+	}
+	return rayHit;
+}
+
+template<typename T>
+inline void SpatialHashGrid<T>::Clear() {
+	for (unsigned int i = 0; i < _cells.size(); i++) {
+		_cells[i] = Cell();
+	}
+	_objectsInserted.clear();
+	_objectCount = 0;
+	_largestRadius = 0.f;
+	_firstFreeObject = -1;
+}
+
+//Objects stay in the grid between frames, so there is nothing to reset here
+template<typename T>
+inline void SpatialHashGrid<T>::EndFrame() {}
+
+template<typename T>
+inline void SpatialHashGrid<T>::Render() {
+	for (int y = 0; y < _cellsY; y++) {
+		for (int x = 0; x < _cellsX; x++) {
+			if (_cells[y * _cellsX + x].objectCount == 0) {
+				continue;
+			}
+			const Vector2<float> min(_boundary.min.x + x * _cellSize, _boundary.min.y + y * _cellSize);
+			const Vector2<float> max(min.x + _cellSize, min.y + _cellSize);
+			debugDrawer->AddDebugRectangle(DebugChannel::SpatialIndex, Vector2<float>(min.x + _cellSize * 0.5f, min.y + _cellSize * 0.5f), min, max, { 255, 125, 0, 255 });
+		}
+	}
+}
+
+template<typename T>
+inline const unsigned int SpatialHashGrid<T>::GetObjectCount() const {
+	return _objectCount;
+}
+
+template<typename T>
+inline const unsigned int SpatialHashGrid<T>::GetCellCount() const {
+	return (unsigned int)_cells.size();
+}
+
+//Positions outside the arena are clamped to the border cells
+template<typename T>
+inline const int SpatialHashGrid<T>::GetCellX(float positionX) const {
+	const int cellX = (int)((positionX - _boundary.min.x) / _cellSize);
+	return cellX < 0 ? 0 : (cellX >= _cellsX ? _cellsX - 1 : cellX);
+}
+
+template<typename T>
+inline const int SpatialHashGrid<T>::GetCellY(float positionY) const {
+	const int cellY = (int)((positionY - _boundary.min.y) / _cellSize);
+	return cellY < 0 ? 0 : (cellY >= _cellsY ? _cellsY - 1 : cellY);
+}
+
+template<typename T>
+inline const int SpatialHashGrid<T>::GetCellIndex(Vector2<float> position) const {
+	return GetCellY(position.y) * _cellsX + GetCellX(position.x);
+}
+
+template<typename T>
+inline void SpatialHashGrid<T>::LinkObject(int objectIndex, int cellIndex) {
+	InsertedObject& insertedObject = _objectsInserted[objectIndex];
+	Cell& cell = _cells[cellIndex];
+	insertedObject.cell = cellIndex;
+	insertedObject.previousObject = -1;
+	insertedObject.nextObject = cell.firstObject;
+	if (cell.firstObject >= 0) {
+		_objectsInserted[cell.firstObject].previousObject = objectIndex;
+	}
+	cell.firstObject = objectIndex;
+	cell.objectCount++;
+}
+
+template<typename T>
+inline void SpatialHashGrid<T>::UnlinkObject(int objectIndex) {
+	InsertedObject& insertedObject = _objectsInserted[objectIndex];
+	Cell& cell = _cells[insertedObject.cell];
+	if (insertedObject.previousObject >= 0) {
+		_objectsInserted[insertedObject.previousObject].nextObject = insertedObject.nextObject;
+	} else {
+		cell.firstObject = insertedObject.nextObject;
+	}
+	if (insertedObject.nextObject >= 0) {
+		_objectsInserted[insertedObject.nextObject].previousObject = insertedObject.previousObject;
+	}
+	cell.objectCount--;
+	insertedObject.cell = -1;
+	insertedObject.previousObject = -1;
+	insertedObject.nextObject = -1;
+}
+
+template<typename T>
+inline const AABB SpatialHashGrid<T>::GetCellBounds(int cellX, int cellY, float margin) const {
+	AABB cellBounds;
+	cellBounds.min = Vector2<float>(_boundary.min.x + cellX * _cellSize - margin, _boundary.min.y + cellY * _cellSize - margin);
+	cellBounds.max = Vector2<float>(cellBounds.min.x + _cellSize + margin * 2.f, cellBounds.min.y + _cellSize + margin * 2.f);
+	if (cellX == 0) {
+		cellBounds.min.x = -FLT_MAX;
+	}
+	if (cellX == _cellsX - 1) {
+		cellBounds.max.x = FLT_MAX;
+	}
+	if (cellY == 0) {
+		cellBounds.min.y = -FLT_MAX;
+	}
+	if (cellY == _cellsY - 1) {
+		cellBounds.max.y = FLT_MAX;
+	}
+	return cellBounds;
+}
@@ -0,0 +1,195 @@
+#pragma once
+#include "collision.h"
+#include "vector2.h"
+
+#include <vector>
+
+template<typename T>
+struct NearestObject {
+	T object;
+	Circle circleCollider;
+	float distance = 0.f;
+};
+
+template<typename T>
+struct RayHit {
+	T object;
+	Circle circleCollider;
+	Vector2<float> position = { 0.f, 0.f };
+	Vector2<float> normal = { 0.f, 0.f };
+	float distance = 0.f;
+	bool objectHit = false;
+};
+
+//An object in the index that overlaps one of the colliders passed to QueryPairs
+template<typename T>
+struct CollisionPair {
+	//The index of the collider in the vector that was passed to QueryPairs
+	unsigned int queryIndex = 0;
+	T object;
+	Circle circleCollider;
+};
+
+/*Called for every object a query finds, without copying the object.
+Returning false from Visit stops the query early*/
+template<typename T>
+class QueryVisitor {
+public:
+	QueryVisitor() {}
+	virtual ~QueryVisitor() {}
+
+	virtual bool Visit(const T& object, const Circle& circleCollider) = 0;
+};
+
+/*Shared interface for the structures that are used to find objects close to a collider.
+Every inserted object gets a handle back which is passed to Update and Remove.
+Indices that are rebuilt every frame ignore the handle in Update and insert the object again,
+indices that are updated incrementally only move the object when it has left the area it was placed in*/
+template<typename T>
+class SpatialIndex {
+public:
+	SpatialIndex() {}
+	virtual ~SpatialIndex() {}
+
+	//Returns a handle to the inserted object, or -1 if the object is outside the index
+	virtual int Insert(T object, Circle circleCollider) = 0;
+	virtual int Update(int handle, T object, Circle circleCollider) = 0;
+	virtual void Remove(int handle) = 0;
+	/*Updates every object and writes the new handles back, the three vectors are in the same order.
+	Indices that are rebuilt every frame override this to build the whole index in one go*/
+	virtual void BulkUpdate(const std::vector<T>& objects, const std::vector<Circle>& circleColliders, std::vector<int>& handles);
+
+	virtual std::vector<T> Query(Circle range) = 0;
+	//Clears the vector and fills it, reusing the memory it already has so repeated queries don't allocate
+	virtual void Query(Circle range, std::vector<T>& objectsFound) = 0;
+	//Returns false if the visitor stopped the query early
+	virtual bool Query(Circle range, QueryVisitor<T>& visitor) = 0;
+
+	/*Finds the k objects with their center closest to the position, objects further away than maxRadius are skipped.
+	The vector is cleared and sorted from the closest to the furthest object*/
+	virtual void QueryNearest(Vector2<float> position, unsigned int k, float maxRadius, std::vector<NearestObject<T>>& nearestObjects) = 0;
+
+	virtual void QueryRange(AABB range, std::vector<T>& objectsFound) = 0;
+	virtual bool QueryRange(AABB range, QueryVisitor<T>& visitor) = 0;
+
+	//Returns the first object along the ray, the direction doesn't have to be normalized
+	virtual RayHit<T> QueryRay(Ray ray) = 0;
+
+	/*Clears the vector and fills it with every overlap between the colliders and the objects in the index.
+	The default runs one query per collider, indices that keep their objects sorted override it to do it in one sweep*/
+	virtual void QueryPairs(const std::vector<Circle>& circleColliders, std::vector<CollisionPair<T>>& pairs);
+
+	virtual void Clear() = 0;
+	//Called once at the end of every frame
+	virtual void EndFrame() = 0;
+
+	virtual void Render() = 0;
+};
+
+template<typename T>
+inline void SpatialIndex<T>::BulkUpdate(const std::vector<T>& objects, const std::vector<Circle>& circleColliders, std::vector<int>& handles) {
+	for (unsigned int i = 0; i < objects.size(); i++) {
+		handles[i] = Update(handles[i], objects[i], circleColliders[i]);
+	}
+}
+
+//Adds every object the query finds as a pair with the collider that is being queried
+template<typename T>
+class PairVisitor : public QueryVisitor<T> {
+public:
+	PairVisitor(std::vector<CollisionPair<T>>& pairs) : _pairs(pairs) {}
+
+	bool Visit(const T& object, const Circle& circleCollider) override;
+
+	unsigned int queryIndex = 0;
+
+private:
+	std::vector<CollisionPair<T>>& _pairs;
+};
+
+template<typename T>
+inline bool PairVisitor<T>::Visit(const T& object, const Circle& circleCollider) {
+	CollisionPair<T> collisionPair;
+	collisionPair.queryIndex = queryIndex;
+	collisionPair.object = object;
+	collisionPair.circleCollider = circleCollider;
+	_pairs.emplace_back(collisionPair);
+	return true;
+}
+
+template<typename T>
+inline void SpatialIndex<T>::QueryPairs(const std::vector<Circle>& circleColliders, std::vector<CollisionPair<T>>& pairs) {
+	pairs.clear();
+	PairVisitor<T> pairVisitor(pairs);
+	for (unsigned int i = 0; i < circleColliders.size(); i++) {
+		pairVisitor.queryIndex = i;
+		Query(circleColliders[i], pairVisitor);
+	}
+}
+
+//Used by the indices so the same loops work for both circle and rectangle ranges
+inline bool RangeIntersect(Circle range, Circle circleCollider) {
+	return CircleIntersect(range, circleCollider);
+}
+
+inline bool RangeIntersect(AABB range, Circle circleCollider) {
+	return AABBCircleIntersect(range, circleCollider);
+}
+
+inline bool RangeIntersect(Circle range, AABB box) {
+	return AABBCircleIntersect(box, range);
+}
+
+inline bool RangeIntersect(AABB range, AABB box) {
+	return AABBIntersect(range, box);
+}
+
+inline AABB RangeBounds(Circle range) {
+	return AABB::makeFromPositionSize(range.position, range.radius * 2.f, range.radius * 2.f);
+}
+
+inline AABB RangeBounds(AABB range) {
+	return range;
+}
+
+//The furthest an object can be and still be one of the k nearest
+template<typename T>
+inline float NearestCutoff(const std::vector<NearestObject<T>>& nearestObjects, unsigned int k, float maxRadius) {
+	return nearestObjects.size() >= k ? nearestObjects.back().distance : maxRadius;
+}
+
+//Adds the object if it's closer than one of the k objects in the list, the list is kept sorted
+template<typename T>
+inline void AddNearestObject(std::vector<NearestObject<T>>& nearestObjects, unsigned int k, const T& object,
+	const Circle& circleCollider, float distance) {
+	if (k == 0 || (nearestObjects.size() >= k && distance >= nearestObjects.back().distance)) {
+		return;
+	}
+	if (nearestObjects.size() >= k) {
+		nearestObjects.pop_back();
+	}
+	unsigned int index = nearestObjects.size();
+	while (index > 0 && nearestObjects[index - 1].distance > distance) {
+		index--;
+	}
+	NearestObject<T> nearestObject;
+	nearestObject.object = object;
+	nearestObject.circleCollider = circleCollider;
+	nearestObject.distance = distance;
+	nearestObjects.insert(nearestObjects.begin() + index, nearestObject);
+}
+
+//Keeps the hit if it's closer than the one that was found before
+template<typename T>
+inline void SetClosestRayHit(RayHit<T>& rayHit, Ray ray, const T& object, const Circle& circleCollider) {
+	float distance = 0.f;
+	if (!RayCircleIntersect(ray, circleCollider, distance) || (rayHit.objectHit && distance >= rayHit.distance)) {
+		return;
+	}
+	rayHit.object = object;
+	rayHit.circleCollider = circleCollider;
+	rayHit.distance = distance;
+	rayHit.position = ray.startPosition + ray.direction * distance;
+	rayHit.normal = (rayHit.position - circleCollider.position).normalized();
+	rayHit.objectHit = true;
+}
@@ -1,23 +1,53 @@
 #include "sprite.h"
 #include "gameEngine.h"
+#include "rotatedSprite.h"
+#include "spriteBatcher.h"
+#include "textureCache.h"
 
 void Sprite::Load(const char* path) {
 	texture = IMG_LoadTexture(renderer, path);
 	SDL_QueryTexture(texture, NULL, NULL, &w, &h);
+	x = 0;
+	y = 0;
+	textureWidth = w;
+	textureHeight = h;
 }
 
+//While the sprite batcher is batching, the sprites are added to it instead of being drawn straight away
 void Sprite::Render(Vector2<float> position) {
+	if (spriteBatcher && spriteBatcher->IsBatching()) {
+		spriteBatcher->Draw(texture, textureWidth, textureHeight, { x, y, w, h }, { position.x, position.y, (float)w, (float)h }, 0.f);
+		return;
+	}
+	SDL_Rect source = { x, y, w, h };
 	SDL_Rect rect = { (int)position.x, (int)position.y, w, h };
-	SDL_RenderCopy(renderer, texture, NULL, &rect);
+	SDL_RenderCopy(renderer, texture, &source, &rect);
 }
 
 void Sprite::RenderCentered(Vector2<float> position) {
+	if (spriteBatcher && spriteBatcher->IsBatching()) {
+		spriteBatcher->Draw(texture, textureWidth, textureHeight, { x, y, w, h }, { position.x - w * 0.5f, position.y - h * 0.5f, (float)w, (float)h }, 0.f);
+		return;
+	}
+	SDL_Rect source = { x, y, w, h };
 	SDL_Rect rect = { (int)position.x - w / 2, (int)position.y - h / 2, w, h };
-	SDL_RenderCopy(renderer, texture, nullptr, &rect);
+	SDL_RenderCopy(renderer, texture, &source, &rect);
 }
 
 void Sprite::RenderWithOrientation(Vector2<float> position, float orientation) {
-	SDL_Rect source = { 0, 0, w, h };
+	if (!rotatedSpriteRequested && !path.empty() && textureCache && textureCache->GetPreRotationAngles() > 0) {
+		rotatedSpriteRequested = true;
+		rotatedSprite = textureCache->GetRotatedSprite(path.c_str(), w, h);
+	}
+	if (rotatedSprite) {
+		rotatedSprite->RenderCentered(0, position, orientation);
+		return;
+	}
+	if (spriteBatcher && spriteBatcher->IsBatching()) {
+		spriteBatcher->Draw(texture, textureWidth, textureHeight, { x, y, w, h }, { position.x - w * 0.5f, position.y - h * 0.5f, (float)w, (float)h }, orientation);
+		return;
+	}
+	SDL_Rect source = { x, y, w, h };
 	SDL_Rect destination = { (int)position.x - w / 2, (int)position.y - h / 2, w, h };
 	SDL_Point center = { w / 2, h / 2 };
 	SDL_RenderCopyEx(renderer, texture, &source, &destination, orientation * 180 / PI, &center, SDL_FLIP_NONE);
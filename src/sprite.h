@@ -3,6 +3,11 @@
 
 #include "vector2.h"
 
+#include <memory>
+#include <string>
+
+struct RotatedSprite;
+
 struct Sprite {
 	void Load(const char* path);
 	void Render(Vector2<float> position);
@@ -12,4 +17,16 @@ struct Sprite {
 	SDL_Texture* texture;
 	int w;
 	int h;
+	//Where the sprite is in the texture, which is only somewhere else than the top left corner when it's packed in an atlas
+	int x;
+	int y;
+	int textureWidth;
+	int textureHeight;
+
+	//The path the texture cache loaded it from, empty if it was loaded some other way
+	std::string path;
+	/*Only there when the texture cache pre-rotates sprites, then it's drawn instead of rotating the sprite every time.
+	It's only asked for the first time the sprite is drawn with an orientation, so sprite sheets and sprites that are never rotated don't get one*/
+	std::shared_ptr<RotatedSprite> rotatedSprite;
+	bool rotatedSpriteRequested = false;
 };
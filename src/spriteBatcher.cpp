@@ -0,0 +1,93 @@
+#include "spriteBatcher.h"
+
+#include <cmath>
+
+void SpriteBatcher::Begin() {
+	_batching = true;
+	_spriteCount = 0;
+	for (unsigned int i = 0; i < _usedBatches; i++) {
+		_spriteBatches[i].vertices.clear();
+		_spriteBatches[i].indices.clear();
+	}
+	_usedBatches = 0;
+}
+
+void SpriteBatcher::End() {
+	_batching = false;
+	_lastDrawCalls = 0;
+	for (unsigned int i = 0; i < _usedBatches; i++) {
+		SpriteBatch& spriteBatch = _spriteBatches[i];
+		if (spriteBatch.indices.empty()) {
+			continue;
+		}
+		SDL_RenderGeometry(_renderer, spriteBatch.texture, spriteBatch.vertices.data(), (int)spriteBatch.vertices.size(),
+			spriteBatch.indices.data(), (int)spriteBatch.indices.size());
+		_lastDrawCalls++;
+	}
+	_lastSpriteCount = _spriteCount;
+}
+
+const bool SpriteBatcher::IsBatching() const {
+	return _batching;
+}
+
+void SpriteBatcher::Draw(SDL_Texture* texture, int textureWidth, int textureHeight, SDL_Rect source, SDL_FRect destination, float orientation) {
+	if (!texture || textureWidth <= 0 || textureHeight <= 0) {
+		return;
+	}
+	//Only a few textures are used in a frame, so the batch is just searched for
+	unsigned int batchIndex = 0;
+	while (batchIndex < _usedBatches && _spriteBatches[batchIndex].texture != texture) {
+		batchIndex++;
+	}
+	if (batchIndex == _usedBatches) {
+		if (_usedBatches == _spriteBatches.size()) {
+			_spriteBatches.emplace_back();
+		}
+		_spriteBatches[batchIndex].texture = texture;
+		_usedBatches++;
+	}
+	SpriteBatch& spriteBatch = _spriteBatches[batchIndex];
+
+	const float halfWidth = destination.w * 0.5f;
+	const float halfHeight = destination.h * 0.5f;
+	const float centerX = destination.x + halfWidth;
+	const float centerY = destination.y + halfHeight;
+	const float cosine = std::cos(orientation);
+	const float sine = std::sin(orientation);
+
+	const float u0 = (float)source.x / textureWidth;
+	const float v0 = (float)source.y / textureHeight;
+	const float u1 = (float)(source.x + source.w) / textureWidth;
+	const float v1 = (float)(source.y + source.h) / textureHeight;
+
+	const float cornerX[4] = { -halfWidth, halfWidth, halfWidth, -halfWidth };
+	const float cornerY[4] = { -halfHeight, -halfHeight, halfHeight, halfHeight };
+	const float cornerU[4] = { u0, u1, u1, u0 };
+	const float cornerV[4] = { v0, v0, v1, v1 };
+
+	const int firstVertex = (int)spriteBatch.vertices.size();
+	for (unsigned int i = 0; i < 4; i++) {
+		SDL_Vertex vertex;
+		//The y axis points down, so this turns the sprite clockwise the same way SDL_RenderCopyEx does
+		vertex.position.x = centerX + cornerX[i] * cosine - cornerY[i] * sine;
+		vertex.position.y = centerY + cornerX[i] * sine + cornerY[i] * cosine;
+		vertex.color = { 255, 255, 255, 255 };
+		vertex.tex_coord.x = cornerU[i];
+		vertex.tex_coord.y = cornerV[i];
+		spriteBatch.vertices.emplace_back(vertex);
+	}
+	const int quadIndices[6] = { 0, 1, 2, 0, 2, 3 };
+	for (unsigned int i = 0; i < 6; i++) {
+		spriteBatch.indices.emplace_back(firstVertex + quadIndices[i]);
+	}
+	_spriteCount++;
+}
+
+const unsigned int SpriteBatcher::GetLastSpriteCount() const {
+	return _lastSpriteCount;
+}
+
+const unsigned int SpriteBatcher::GetLastDrawCalls() const {
+	return _lastDrawCalls;
+}
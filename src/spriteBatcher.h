@@ -0,0 +1,42 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include <vector>
+
+/*Collects the sprites drawn between Begin and End and draws all the ones that share a texture with a single SDL_RenderGeometry call.
+The corners of every sprite are rotated here instead of by SDL_RenderCopyEx, which is a slow rotated blit per sprite without a GPU.
+The batches are drawn in the order their textures were first used, so sprites with different textures can end up in a different order than they were drawn in*/
+class SpriteBatcher {
+public:
+	SpriteBatcher(SDL_Renderer* renderer) : _renderer(renderer) {}
+	~SpriteBatcher() {}
+
+	void Begin();
+	void End();
+	const bool IsBatching() const;
+
+	//The orientation is in radians and the sprite is rotated around the center of the destination
+	void Draw(SDL_Texture* texture, int textureWidth, int textureHeight, SDL_Rect source, SDL_FRect destination, float orientation);
+
+	const unsigned int GetLastSpriteCount() const;
+	const unsigned int GetLastDrawCalls() const;
+
+private:
+	struct SpriteBatch {
+		SDL_Texture* texture = nullptr;
+		std::vector<SDL_Vertex> vertices;
+		std::vector<int> indices;
+	};
+
+	SDL_Renderer* _renderer = nullptr;
+
+	//Kept between frames so the vertices don't have to be allocated again
+	std::vector<SpriteBatch> _spriteBatches;
+	unsigned int _usedBatches = 0;
+
+	unsigned int _spriteCount = 0;
+	unsigned int _lastSpriteCount = 0;
+	unsigned int _lastDrawCalls = 0;
+
+	bool _batching = false;
+};
@@ -1,26 +1,54 @@
 #include "spriteSheet.h"
 #include "gameEngine.h"
+#include "rotatedSprite.h"
+#include "sprite.h"
+#include "spriteBatcher.h"
+#include "textureCache.h"
 
 void SpriteSheet::Load(const char* path, int width, int height) {
-	texture = IMG_LoadTexture(renderer, path);
+	//Loaded through the texture cache, so a sheet in the atlas is drawn from the atlas too
+	sheetSprite = textureCache->GetSprite(path);
+	texture = sheetSprite->texture;
+	x = sheetSprite->x;
+	y = sheetSprite->y;
+	textureWidth = sheetSprite->textureWidth;
+	textureHeight = sheetSprite->textureHeight;
 	w = width;
 	h = height;
+	rotatedSheet = textureCache->GetRotatedSprite(path, width, height);
 }
 
+//While the sprite batcher is batching, the sprites are added to it instead of being drawn straight away
 void SpriteSheet::Render(int spriteIndex, Vector2<float> position) {
-	SDL_Rect source = { spriteIndex * w, 0, w, h };
+	SDL_Rect source = { x + spriteIndex * w, y, w, h };
+	if (spriteBatcher && spriteBatcher->IsBatching()) {
+		spriteBatcher->Draw(texture, textureWidth, textureHeight, source, { position.x, position.y, (float)w, (float)h }, 0.f);
+		return;
+	}
 	SDL_Rect destination = { (int)position.x, (int)position.y, w, h };
 	SDL_RenderCopy(renderer, texture, &source, &destination);
 }
 
 void SpriteSheet::RenderCentered(int spriteIndex, Vector2<float> position) {
-	SDL_Rect source = { spriteIndex * w, 0, w, h };
+	SDL_Rect source = { x + spriteIndex * w, y, w, h };
+	if (spriteBatcher && spriteBatcher->IsBatching()) {
+		spriteBatcher->Draw(texture, textureWidth, textureHeight, source, { position.x - w * 0.5f, position.y - h * 0.5f, (float)w, (float)h }, 0.f);
+		return;
+	}
 	SDL_Rect destination = { (int)position.x - w / 2, (int)position.y - h / 2, w, h };
 	SDL_RenderCopy(renderer, texture, &source, &destination);
 }
 
 void SpriteSheet::RenderWithOrientation(int spriteIndex, Vector2<float> position, float orientation) {
-	SDL_Rect source = { spriteIndex * w, 0, w, h };
+	if (rotatedSheet) {
+		rotatedSheet->RenderCentered(spriteIndex, position, orientation);
+		return;
+	}
+	SDL_Rect source = { x + spriteIndex * w, y, w, h };
+	if (spriteBatcher && spriteBatcher->IsBatching()) {
+		spriteBatcher->Draw(texture, textureWidth, textureHeight, source, { position.x - w * 0.5f, position.y - h * 0.5f, (float)w, (float)h }, orientation);
+		return;
+	}
 	SDL_Rect destination = { (int)position.x - w / 2, (int)position.y - h / 2, w, h };
 	SDL_Point center = { w / 2, h / 2 };
 
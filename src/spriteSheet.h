@@ -3,6 +3,11 @@
 
 #include "vector2.h"
 
+#include <memory>
+
+struct RotatedSprite;
+struct Sprite;
+
 struct SpriteSheet {
 	void Load(const char* path, int width, int height);
 	void Render(int spriteIndex, Vector2<float> position);
@@ -12,5 +17,15 @@ struct SpriteSheet {
 	SDL_Texture* texture;
 	int w;
 	int h;
+	//Where the sheet is in the texture and how big the whole texture is, the sheet can be packed in the texture atlas
+	int x;
+	int y;
+	int textureWidth;
+	int textureHeight;
+
+	//Keeps the texture alive
+	std::shared_ptr<Sprite> sheetSprite;
+	//Every frame pre-rotated, only there when the texture cache pre-rotates sprites
+	std::shared_ptr<RotatedSprite> rotatedSheet;
 };
 
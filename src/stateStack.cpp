@@ -3,6 +3,7 @@
 #include "dataStructuresAndMethods.h"
 #include "enemyManager.h"
 #include "gameEngine.h"
+#include "imGuiManager.h"
 #include "objectBase.h"
 #include "obstacleManager.h"
 #include "playerCharacter.h"
@@ -10,7 +11,9 @@
 #include "quadTree.h"
 #include "textSprite.h"
 #include "timerManager.h"
+#include "visibilityCuller.h"
 
+#include <fstream>
 #include <vector>
 
 Button::Button(const char* buttonText, int height, int width, Vector2<float> position) {
@@ -37,7 +40,7 @@ bool Button::ClickedOn() {
 }
 
 void Button::Render() {
-	debugDrawer->AddDebugBox(_position, _boxCollider.min, _boxCollider.max, _buttonColor);
+	debugDrawer->AddDebugBox(DebugChannel::Interface, _position, _boxCollider.min, _boxCollider.max, _buttonColor);
 }
 
 void Button::RenderText() {
@@ -101,10 +104,10 @@ InGameState::InGameState() {
 void InGameState::SetButtonPositions() {}
 
 void InGameState::Update() {
-	//objectBaseQuadTree->Insert(playerCharacter, playerCharacter->GetCircleCollider());
+	//objectBaseQuadTree->Insert(CollisionLayer::Player, playerCharacter, playerCharacter->GetCircleCollider());
 	
+	//The projectiles update their layer themselves once they have moved
 	enemyManager->UpdateQuadTree();
-	projectileManager->UpdateQuadTree();
 
 	enemyManager->Update();
 	obstacleManager->UpdateObstacles();
@@ -112,6 +115,23 @@ void InGameState::Update() {
 	playerCharacter->Update();
 	timerManager->Update();
 
+	//Everything that was spawned or killed this frame is added or removed here, once nothing is looping over the enemies or projectiles
+	enemyManager->ApplyCommands();
+	projectileManager->ApplyCommands();
+
+	//What is on the screen is found once here, after everything has moved, and the render functions only draw that
+	visibilityCuller->Cull(CollisionLayer::Enemy, enemyManager->GetActiveEnemyCount());
+	visibilityCuller->Cull(CollisionLayer::Projectile, projectileManager->GetActiveProjectileCount());
+	visibilityCuller->ShowStatistics();
+
+	enemyManager->ShowPoolStatistics();
+	projectileManager->ShowPoolStatistics();
+	if (imGuiHandler->Button("Object pools", "Write to poolStatistics.txt")) {
+		std::ofstream file("poolStatistics.txt");
+		enemyManager->WritePoolStatistics(file);
+		projectileManager->WritePoolStatistics(file);
+	}
+
 
 }
 
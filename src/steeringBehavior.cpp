@@ -84,14 +84,13 @@ SteeringOutput ArriveBehavior::Steering(BehaviorData behaviorData, EnemyBase& en
 }
 
 SteeringOutput CollisionAvoidanceBehavior::Steering(BehaviorData behaviorData, EnemyBase& enemy) {
-	for (unsigned int i = 0; i < enemy.GetQueriedObjects().size(); i++) {
-		if (enemy.GetQueriedObjects()[i]->GetObjectType() != ObjectType::Enemy) {
+	//The enemies only query the enemy layer, so everything in the list is an enemy, and the list keeps them alive while this runs
+	const std::vector<std::shared_ptr<ObjectBase>>& queriedObjects = enemy.GetQueriedObjects();
+	for (unsigned int i = 0; i < queriedObjects.size(); i++) {
+		if (enemy.GetObjectID() == queriedObjects[i]->GetObjectID()) {
 			continue;
 		}
-		if (enemy.GetObjectID() == enemy.GetQueriedObjects()[i]->GetObjectID()) {
-			continue;
-		}
-		std::shared_ptr<EnemyBase> targetEnemy = std::static_pointer_cast<EnemyBase>(enemy.GetQueriedObjects()[i]);
+		const EnemyBase* targetEnemy = static_cast<const EnemyBase*>(queriedObjects[i].get());
 
 		_direction = targetEnemy->GetPosition() - enemy.GetPosition();
 
@@ -109,7 +108,7 @@ SteeringOutput CollisionAvoidanceBehavior::Steering(BehaviorData behaviorData, E
 		}
 		if (_timeToCollision < _shortestTime) {
 			_shortestTime = _timeToCollision;
-			_firstTargetPosition = enemy.GetQueriedObjects()[i]->GetPosition();
+			_firstTargetPosition = queriedObjects[i]->GetPosition();
 			_firstMinSeparation = _minSeparation;
 			_firstDistance = _distance;
 			_firstRelativePos = _relativePos;
@@ -164,20 +163,21 @@ SteeringOutput ObstacleAvoidanceBehavior::Steering(BehaviorData behaviorData, En
 	_whiskerB.length = _ray.length * 0.75f;
 	_whiskerB.direction = RotateVector(PI * 0.25, enemy.GetPosition(), enemy.GetPosition() + _ray.direction);
 
-	//debugDrawer->AddDebugLine(enemy->GetPosition(), enemy->GetPosition() + _ray.direction * _ray.length, {0, 255, 0, 255 });
-	//debugDrawer->AddDebugLine(enemy->GetPosition(), enemy->GetPosition() + _whiskerA.direction * _whiskerA.length, { 0, 255, 0, 255 });
-	//debugDrawer->AddDebugLine(enemy->GetPosition(), enemy->GetPosition() + _whiskerB.direction * _whiskerB.length, { 0, 255, 0, 255 });
+	//debugDrawer->AddDebugLine(DebugChannel::Steering, enemy->GetPosition(), enemy->GetPosition() + _ray.direction * _ray.length, {0, 255, 0, 255 });
+	//debugDrawer->AddDebugLine(DebugChannel::Steering, enemy->GetPosition(), enemy->GetPosition() + _whiskerA.direction * _whiskerA.length, { 0, 255, 0, 255 });
+	//debugDrawer->AddDebugLine(DebugChannel::Steering, enemy->GetPosition(), enemy->GetPosition() + _whiskerB.direction * _whiskerB.length, { 0, 255, 0, 255 });
 
-	for (int i = 0; i < obstacleManager->GetWalls().size(); i++) {
-		_rayPoint = rayCast->RayCastToAABB(obstacleManager->GetWalls()[i]->GetCollider(), _ray);
+	const std::vector<std::shared_ptr<Wall>>& walls = obstacleManager->GetWalls();
+	for (unsigned int i = 0; i < walls.size(); i++) {
+		_rayPoint = rayCast->RayCastToAABB(walls[i]->GetCollider(), _ray);
 		if (_rayPoint.pointHit) {
 			break;
 		}
-		_rayPoint = rayCast->RayCastToAABB(obstacleManager->GetWalls()[i]->GetCollider(), _whiskerA);
+		_rayPoint = rayCast->RayCastToAABB(walls[i]->GetCollider(), _whiskerA);
 		if (_rayPoint.pointHit) {
 			break;
 		}
-		_rayPoint = rayCast->RayCastToAABB(obstacleManager->GetWalls()[i]->GetCollider(), _whiskerB);
+		_rayPoint = rayCast->RayCastToAABB(walls[i]->GetCollider(), _whiskerB);
 		if (_rayPoint.pointHit) {
 			break;
 		}
@@ -208,15 +208,13 @@ SteeringOutput SeparationBehavior::Steering(BehaviorData behaviorData, EnemyBase
 	_result.linearVelocity = { 0.f, 0.f };
 
 	//Loops through all enemies detected by the quadtree
-	for (unsigned int i = 0; i < enemy.GetQueriedObjects().size(); i++) {
-		if (enemy.GetQueriedObjects()[i]->GetObjectType() == ObjectType::Projectile) {
-			continue;
-		}
+	const std::vector<std::shared_ptr<ObjectBase>>& queriedObjects = enemy.GetQueriedObjects();
+	for (unsigned int i = 0; i < queriedObjects.size(); i++) {
 		//Skips if the enemy in the loop is the same one as the current one
-		if (enemy.GetObjectID() == enemy.GetQueriedObjects()[i]->GetObjectID()) {
+		if (enemy.GetObjectID() == queriedObjects[i]->GetObjectID()) {
 			continue;
 		}
-		_targetPosition = enemy.GetQueriedObjects()[i]->GetPosition();
+		_targetPosition = queriedObjects[i]->GetPosition();
 		_direction = _targetPosition - enemy.GetPosition();
 		_distance = _direction.absolute();
 		//If the enemies are closer to each other than the threshold,
@@ -252,7 +250,9 @@ SteeringOutput WanderBehavior::Steering(BehaviorData behaviorData, EnemyBase& en
 		(OrientationAsVector(enemy.GetOrientation()) * behaviorData.wanderOffset);
 
 	behaviorData.targetPosition += OrientationAsVector(behaviorData.targetOrientation) * behaviorData.wanderRadius;
-	debugDrawer->AddDebugCross(behaviorData.targetPosition, 25.f, { 0, 255, 0, 255 });
+	if (debugDrawer->IsChannelEnabled(DebugChannel::Steering)) {
+		debugDrawer->AddDebugCross(DebugChannel::Steering, behaviorData.targetPosition, 25.f, { 0, 255, 0, 255 });
+	}
 
 	_result = FaceBehavior::Steering(behaviorData, enemy);
 	_result.linearVelocity = OrientationAsVector(enemy.GetOrientation()) * behaviorData.maxLinearAcceleration;
@@ -0,0 +1,297 @@
+#include "steeringEngine.h"
+
+#include "dataStructuresAndMethods.h"
+#include "gameEngine.h"
+
+#include <cfloat>
+#include <cmath>
+
+void SteeringEngine::SetArchetype(EnemyType enemyType, const SteeringArchetype& steeringArchetype) {
+	_archetypes[(unsigned int)enemyType] = steeringArchetype;
+	_archetypeSet[(unsigned int)enemyType] = 1;
+}
+
+const bool SteeringEngine::HasArchetype(EnemyType enemyType) const {
+	return _archetypeSet[(unsigned int)enemyType] != 0;
+}
+
+void SteeringEngine::Clear() {
+	_archetype.clear();
+	_positionX.clear();
+	_positionY.clear();
+	_velocityX.clear();
+	_velocityY.clear();
+	_orientation.clear();
+	_rotation.clear();
+	_targetX.clear();
+	_targetY.clear();
+}
+
+void SteeringEngine::Reserve(unsigned int agentCount) {
+	_archetype.reserve(agentCount);
+	_positionX.reserve(agentCount);
+	_positionY.reserve(agentCount);
+	_velocityX.reserve(agentCount);
+	_velocityY.reserve(agentCount);
+	_orientation.reserve(agentCount);
+	_rotation.reserve(agentCount);
+	_targetX.reserve(agentCount);
+	_targetY.reserve(agentCount);
+}
+
+unsigned int SteeringEngine::AddAgent(EnemyType enemyType, Vector2<float> position, Vector2<float> velocity, float orientation, float rotation, Vector2<float> targetPosition) {
+	_archetype.emplace_back((unsigned char)enemyType);
+	_positionX.emplace_back(position.x);
+	_positionY.emplace_back(position.y);
+	_velocityX.emplace_back(velocity.x);
+	_velocityY.emplace_back(velocity.y);
+	_orientation.emplace_back(orientation);
+	_rotation.emplace_back(rotation);
+	_targetX.emplace_back(targetPosition.x);
+	_targetY.emplace_back(targetPosition.y);
+	return _archetype.size() - 1;
+}
+
+const unsigned int SteeringEngine::GetAgentCount() const {
+	return _archetype.size();
+}
+
+void SteeringEngine::Steer() {
+	//resize keeps the memory, so after the first frame none of the passes allocate
+	const unsigned int agentCount = _archetype.size();
+	_linearX.resize(agentCount);
+	_linearY.resize(agentCount);
+	_angular.resize(agentCount);
+	_separationX.resize(agentCount);
+	_separationY.resize(agentCount);
+	_arrived.resize(agentCount);
+	_outputX.resize(agentCount);
+	_outputY.resize(agentCount);
+	_outputAngular.resize(agentCount);
+	_stopped.resize(agentCount);
+
+	SeekPass();
+	ArrivePass();
+	FacePass();
+	SeparationPass();
+	CombinePass();
+}
+
+void SteeringEngine::SeekPass() {
+	const unsigned int agentCount = _archetype.size();
+	for (unsigned int i = 0; i < agentCount; i++) {
+		const BehaviorData& behaviorData = _archetypes[_archetype[i]].behaviorData;
+		if (!_archetypes[_archetype[i]].seek) {
+			continue;
+		}
+		const float directionX = _targetX[i] - _positionX[i];
+		const float directionY = _targetY[i] - _positionY[i];
+		const float distance = sqrtf(directionX * directionX + directionY * directionY);
+		//Seeking always wants full acceleration, just not more than the top speed
+		float acceleration = behaviorData.maxLinearAcceleration > behaviorData.maxSpeed ? behaviorData.maxSpeed : behaviorData.maxLinearAcceleration;
+		acceleration = distance > 0.f ? acceleration / distance : 0.f;
+		_linearX[i] = directionX * acceleration;
+		_linearY[i] = directionY * acceleration;
+		_arrived[i] = 0;
+	}
+}
+
+void SteeringEngine::ArrivePass() {
+	const unsigned int agentCount = _archetype.size();
+	for (unsigned int i = 0; i < agentCount; i++) {
+		const BehaviorData& behaviorData = _archetypes[_archetype[i]].behaviorData;
+		if (_archetypes[_archetype[i]].seek) {
+			continue;
+		}
+		const float directionX = _targetX[i] - _positionX[i];
+		const float directionY = _targetY[i] - _positionY[i];
+		const float distance = sqrtf(directionX * directionX + directionY * directionY);
+		if (distance < behaviorData.linearTargetRadius) {
+			_linearX[i] = 0.f;
+			_linearY[i] = 0.f;
+			_arrived[i] = 1;
+			continue;
+		}
+		float targetSpeed = behaviorData.maxSpeed;
+		if (distance <= behaviorData.linearSlowDownRadius) {
+			targetSpeed = behaviorData.maxSpeed * distance / behaviorData.linearSlowDownRadius;
+		}
+		//distance can only be zero here if the target radius is zero too
+		const float speedOverDistance = distance > 0.f ? targetSpeed / distance : 0.f;
+		float linearX = (directionX * speedOverDistance - _velocityX[i]) / behaviorData.timeToTarget;
+		float linearY = (directionY * speedOverDistance - _velocityY[i]) / behaviorData.timeToTarget;
+		const float acceleration = sqrtf(linearX * linearX + linearY * linearY);
+		if (acceleration > behaviorData.maxLinearAcceleration) {
+			linearX *= behaviorData.maxLinearAcceleration / acceleration;
+			linearY *= behaviorData.maxLinearAcceleration / acceleration;
+		}
+		_linearX[i] = linearX;
+		_linearY[i] = linearY;
+		_arrived[i] = 0;
+	}
+}
+
+void SteeringEngine::FacePass() {
+	const unsigned int agentCount = _archetype.size();
+	for (unsigned int i = 0; i < agentCount; i++) {
+		const BehaviorData& behaviorData = _archetypes[_archetype[i]].behaviorData;
+		const float directionX = _targetX[i] - _positionX[i];
+		const float directionY = _targetY[i] - _positionY[i];
+		_angular[i] = 0.f;
+		if (directionX == 0.f && directionY == 0.f) {
+			continue;
+		}
+		const float rotation = WrapMinMax(atan2f(directionX, -directionY) - _orientation[i], -PI, PI);
+		const float rotationSize = fabsf(rotation);
+		if (rotationSize < behaviorData.angularTargetRadius) {
+			continue;
+		}
+		float wantedRotation = behaviorData.maxRotation;
+		if (rotationSize <= behaviorData.angularSlowDownRadius) {
+			wantedRotation = behaviorData.maxRotation * rotationSize / behaviorData.angularSlowDownRadius;
+		}
+		wantedRotation *= rotation / rotationSize;
+
+		float angular = (wantedRotation - _rotation[i]) / behaviorData.timeToTarget;
+		if (fabsf(angular) > behaviorData.maxAngularAcceleration) {
+			angular = angular > 0.f ? behaviorData.maxAngularAcceleration : -behaviorData.maxAngularAcceleration;
+		}
+		_angular[i] = angular;
+	}
+}
+
+void SteeringEngine::SeparationPass() {
+	BuildGrid();
+	const unsigned int agentCount = _archetype.size();
+	for (unsigned int i = 0; i < agentCount; i++) {
+		const BehaviorData& behaviorData = _archetypes[_archetype[i]].behaviorData;
+		const float positionX = _positionX[i];
+		const float positionY = _positionY[i];
+		const int column = (int)(_agentCells[i] % _gridColumns);
+		const int row = (int)(_agentCells[i] / _gridColumns);
+		float separationX = 0.f;
+		float separationY = 0.f;
+		for (int y = row - 1; y <= row + 1; y++) {
+			if (y < 0 || y >= (int)_gridRows) {
+				continue;
+			}
+			for (int x = column - 1; x <= column + 1; x++) {
+				if (x < 0 || x >= (int)_gridColumns) {
+					continue;
+				}
+				const unsigned int cell = (unsigned int)y * _gridColumns + (unsigned int)x;
+				for (unsigned int k = _cellStarts[cell]; k < _cellStarts[cell + 1]; k++) {
+					const unsigned int j = _cellAgents[k];
+					const float directionX = _positionX[j] - positionX;
+					const float directionY = _positionY[j] - positionY;
+					const float distanceSquared = directionX * directionX + directionY * directionY;
+					//Skips the agent itself too, and two agents on the same spot don't push each other in SeparationBehavior either
+					if (distanceSquared == 0.f || distanceSquared >= behaviorData.separationThreshold * behaviorData.separationThreshold) {
+						continue;
+					}
+					float strength = behaviorData.decayCoefficient / distanceSquared;
+					if (strength > behaviorData.maxLinearAcceleration) {
+						strength = behaviorData.maxLinearAcceleration;
+					}
+					strength /= sqrtf(distanceSquared);
+					separationX -= directionX * strength;
+					separationY -= directionY * strength;
+				}
+			}
+		}
+		_separationX[i] = separationX;
+		_separationY[i] = separationY;
+	}
+}
+
+void SteeringEngine::CombinePass() {
+	const unsigned int agentCount = _archetype.size();
+	for (unsigned int i = 0; i < agentCount; i++) {
+		const float separationSize = sqrtf(_separationX[i] * _separationX[i] + _separationY[i] * _separationY[i]);
+		if (_archetypes[_archetype[i]].separationFirst) {
+			if (separationSize > FLT_EPSILON) {
+				_outputX[i] = _separationX[i];
+				_outputY[i] = _separationY[i];
+				_outputAngular[i] = 0.f;
+				_stopped[i] = 0;
+			} else {
+				_outputX[i] = _linearX[i];
+				_outputY[i] = _linearY[i];
+				_outputAngular[i] = _angular[i];
+				_stopped[i] = _arrived[i];
+			}
+		} else {
+			_outputX[i] = _separationX[i] + _linearX[i];
+			_outputY[i] = _separationY[i] + _linearY[i];
+			_outputAngular[i] = _angular[i];
+			_stopped[i] = _arrived[i];
+		}
+	}
+}
+
+const SteeringOutput SteeringEngine::GetSteeringOutput(unsigned int index) const {
+	SteeringOutput steeringOutput;
+	steeringOutput.linearVelocity = Vector2<float>(_outputX[index], _outputY[index]);
+	steeringOutput.angularVelocity = _outputAngular[index];
+	return steeringOutput;
+}
+
+const bool SteeringEngine::GetStopped(unsigned int index) const {
+	return _stopped[index] != 0;
+}
+
+void SteeringEngine::BuildGrid() {
+	const unsigned int agentCount = _archetype.size();
+	_cellSize = 1.f;
+	for (unsigned int i = 0; i < _archetypes.size(); i++) {
+		if (_archetypeSet[i] != 0 && _archetypes[i].behaviorData.separationThreshold > _cellSize) {
+			_cellSize = _archetypes[i].behaviorData.separationThreshold;
+		}
+	}
+	_gridMinX = 0.f;
+	_gridMinY = 0.f;
+	float gridMaxX = 0.f;
+	float gridMaxY = 0.f;
+	if (agentCount > 0) {
+		_gridMinX = _positionX[0];
+		_gridMinY = _positionY[0];
+		gridMaxX = _positionX[0];
+		gridMaxY = _positionY[0];
+	}
+	for (unsigned int i = 1; i < agentCount; i++) {
+		_gridMinX = _positionX[i] < _gridMinX ? _positionX[i] : _gridMinX;
+		_gridMinY = _positionY[i] < _gridMinY ? _positionY[i] : _gridMinY;
+		gridMaxX = _positionX[i] > gridMaxX ? _positionX[i] : gridMaxX;
+		gridMaxY = _positionY[i] > gridMaxY ? _positionY[i] : gridMaxY;
+	}
+	//The cells are never smaller than the biggest threshold, so everything close enough is in the cells right around an agent
+	const float widestExtent = gridMaxX - _gridMinX > gridMaxY - _gridMinY ? gridMaxX - _gridMinX : gridMaxY - _gridMinY;
+	if (widestExtent / _cellSize >= (float)_maxGridSize) {
+		_cellSize = widestExtent / (float)(_maxGridSize - 1);
+	}
+	_gridColumns = (unsigned int)((gridMaxX - _gridMinX) / _cellSize) + 1;
+	_gridRows = (unsigned int)((gridMaxY - _gridMinY) / _cellSize) + 1;
+
+	//Counting sort, first how many agents are in each cell, then where each cell ends, then the agents themselves.
+	//The extra cell at the end stays empty, so it ends up holding the agent count
+	_cellStarts.assign(_gridColumns * _gridRows + 1, 0);
+	_agentCells.resize(agentCount);
+	_cellAgents.resize(agentCount);
+	for (unsigned int i = 0; i < agentCount; i++) {
+		unsigned int column = (unsigned int)((_positionX[i] - _gridMinX) / _cellSize);
+		unsigned int row = (unsigned int)((_positionY[i] - _gridMinY) / _cellSize);
+		column = column < _gridColumns ? column : _gridColumns - 1;
+		row = row < _gridRows ? row : _gridRows - 1;
+		_agentCells[i] = row * _gridColumns + column;
+		_cellStarts[_agentCells[i]]++;
+	}
+	for (unsigned int i = 1; i < _cellStarts.size(); i++) {
+		_cellStarts[i] += _cellStarts[i - 1];
+	}
+	//Now every cell has where it ends, filling each cell from its end leaves it with where it starts
+	for (unsigned int i = agentCount; i > 0; i--) {
+		const unsigned int cell = _agentCells[i - 1];
+		_cellStarts[cell]--;
+		_cellAgents[_cellStarts[cell]] = i - 1;
+	}
+}
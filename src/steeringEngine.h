@@ -0,0 +1,94 @@
+#pragma once
+#include "enemyManager.h"
+#include "steeringBehavior.h"
+#include "vector2.h"
+
+#include <vector>
+
+//The parameters every enemy of a type shares, and how its steering groups are combined
+struct SteeringArchetype {
+	BehaviorData behaviorData;
+	//Seeks the target instead of arriving at it
+	bool seek = false;
+	//Only arrives and faces when separation has nothing to say, like the boar's PrioritySteering, otherwise everything is blended
+	bool separationFirst = false;
+};
+
+/*Steers every enemy at once instead of one enemy at a time through PrioritySteering, BlendSteering and the virtual behaviors.
+The enemies are copied into flat arrays, one for each value, and every behavior is a loop of its own over all of them,
+so each loop only touches the few arrays it needs and there's no virtual call or BehaviorData copy per enemy.
+The parameters are kept per archetype, so each enemy only stores which archetype it is.
+It does the same math as SeekBehavior, ArriveBehavior, FaceBehavior and SeparationBehavior*/
+class SteeringEngine {
+public:
+	SteeringEngine() {}
+	~SteeringEngine() {}
+
+	void SetArchetype(EnemyType enemyType, const SteeringArchetype& steeringArchetype);
+	const bool HasArchetype(EnemyType enemyType) const;
+
+	void Clear();
+	void Reserve(unsigned int agentCount);
+	//Returns the index the results of the agent are at
+	unsigned int AddAgent(EnemyType enemyType, Vector2<float> position, Vector2<float> velocity, float orientation, float rotation, Vector2<float> targetPosition);
+	const unsigned int GetAgentCount() const;
+
+	//Runs all the passes and combines them
+	void Steer();
+
+	void SeekPass();
+	void ArrivePass();
+	void FacePass();
+	//Sorts the agents into a grid as wide as the biggest separation threshold, so every agent only looks at the cells around it
+	void SeparationPass();
+	void CombinePass();
+
+	const SteeringOutput GetSteeringOutput(unsigned int index) const;
+	//True if the agent arrived and the steering wants its velocity set to zero, the way ArriveBehavior does it
+	const bool GetStopped(unsigned int index) const;
+
+private:
+	void BuildGrid();
+
+	//Per archetype
+	std::vector<SteeringArchetype> _archetypes = std::vector<SteeringArchetype>((unsigned int)EnemyType::Count);
+	std::vector<unsigned char> _archetypeSet = std::vector<unsigned char>((unsigned int)EnemyType::Count, 0);
+
+	//Per agent
+	std::vector<unsigned char> _archetype;
+	std::vector<float> _positionX;
+	std::vector<float> _positionY;
+	std::vector<float> _velocityX;
+	std::vector<float> _velocityY;
+	std::vector<float> _orientation;
+	std::vector<float> _rotation;
+	std::vector<float> _targetX;
+	std::vector<float> _targetY;
+
+	//What the passes wrote
+	std::vector<float> _linearX;
+	std::vector<float> _linearY;
+	std::vector<float> _angular;
+	std::vector<float> _separationX;
+	std::vector<float> _separationY;
+	std::vector<unsigned char> _arrived;
+
+	//What CombinePass wrote
+	std::vector<float> _outputX;
+	std::vector<float> _outputY;
+	std::vector<float> _outputAngular;
+	std::vector<unsigned char> _stopped;
+
+	//The agents sorted by cell, _cellStarts[c] to _cellStarts[c + 1] are the ones in cell c
+	std::vector<unsigned int> _cellStarts;
+	std::vector<unsigned int> _cellAgents;
+	std::vector<unsigned int> _agentCells;
+	float _cellSize = 1.f;
+	float _gridMinX = 0.f;
+	float _gridMinY = 0.f;
+	unsigned int _gridColumns = 1;
+	unsigned int _gridRows = 1;
+
+	//The agents are spread over no more cells than this along each axis, the cells just get wider if they are far apart
+	const unsigned int _maxGridSize = 256;
+};
@@ -0,0 +1 @@
+#include "sweepAndPrune.h"
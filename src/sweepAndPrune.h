@@ -0,0 +1,395 @@
+#pragma once
+#include "collision.h"
+#include "spatialIndex.h"
+#include "vector2.h"
+
+#include <vector>
+
+#include "debugDrawer.h"
+#include "gameEngine.h"
+
+/*Sweep and prune along the x axis. Every object is an interval from the left to the right edge of its collider,
+and the intervals are kept sorted by their left edge between frames.
+The objects only move a little every frame, so the list is already almost sorted and an insertion sort fixes it in about one pass.
+A query only looks at the intervals that start between its own left edge minus the widest object and its right edge*/
+template<typename T>
+class SweepAndPrune : public SpatialIndex<T> {
+public:
+	SweepAndPrune();
+	~SweepAndPrune();
+
+	int Insert(T object, Circle circleCollider) override;
+	int Update(int handle, T object, Circle circleCollider) override;
+	void Remove(int handle) override;
+
+	std::vector<T> Query(Circle range) override;
+	void Query(Circle range, std::vector<T>& objectsFound) override;
+	bool Query(Circle range, QueryVisitor<T>& visitor) override;
+
+	void QueryNearest(Vector2<float> position, unsigned int k, float maxRadius, std::vector<NearestObject<T>>& nearestObjects) override;
+
+	void QueryRange(AABB range, std::vector<T>& objectsFound) override;
+	bool QueryRange(AABB range, QueryVisitor<T>& visitor) override;
+
+	RayHit<T> QueryRay(Ray ray) override;
+
+	//Sorts the colliders as well and walks both lists at the same time, instead of searching the list once per collider
+	void QueryPairs(const std::vector<Circle>& circleColliders, std::vector<CollisionPair<T>>& pairs) override;
+
+	template<typename Range, typename Callback>
+	bool ForEachInRange(Range range, Callback&& callback);
+
+	void Clear() override;
+	void EndFrame() override;
+
+	void Render() override;
+
+	const unsigned int GetObjectCount() const;
+	//How many steps the insertion sort moved the intervals during the last frame, this stays low as long as the objects move smoothly
+	const unsigned int GetLastFrameSortMoves() const;
+
+private:
+	struct InsertedObject {
+		T object;
+		Circle circleCollider;
+		bool active = false;
+		//Stays true after the object is removed, until the next sort drops its interval
+		bool hasInterval = false;
+		int nextFreeObject = -1;
+	};
+
+	struct Interval {
+		float minX = 0.f;
+		int object = -1;
+	};
+
+	//Called before every query, does nothing if no object has changed since the last sort
+	void SortIntervals();
+	//Returns the first interval that starts at or after the position
+	const unsigned int FindFirstInterval(float positionX) const;
+
+	float _largestRadius = 0.f;
+	unsigned int _objectCount = 0;
+	int _firstFreeObject = -1;
+	bool _intervalsSorted = true;
+
+	unsigned int _sortMoves = 0;
+	unsigned int _lastFrameSortMoves = 0;
+
+	std::vector<InsertedObject> _objectsInserted;
+	std::vector<Interval> _intervals;
+	//The colliders passed to QueryPairs in the order of their left edge, kept so the next frame starts out almost sorted
+	std::vector<unsigned int> _queryOrder;
+};
+
+template<typename T>
+inline SweepAndPrune<T>::SweepAndPrune() {}
+
+template<typename T>
+inline SweepAndPrune<T>::~SweepAndPrune() {
+	Clear();
+}
+
+template<typename T>
+inline int SweepAndPrune<T>::Insert(T object, Circle circleCollider) {
+	int objectIndex = -1;
+	if (_firstFreeObject >= 0) {
+		objectIndex = _firstFreeObject;
+		_firstFreeObject = _objectsInserted[objectIndex].nextFreeObject;
+	} else {
+		objectIndex = (int)_objectsInserted.size();
+		_objectsInserted.emplace_back();
+	}
+	InsertedObject& insertedObject = _objectsInserted[objectIndex];
+	insertedObject.object = object;
+	insertedObject.circleCollider = circleCollider;
+	insertedObject.active = true;
+	insertedObject.nextFreeObject = -1;
+	//A removed object that hasn't been sorted out yet still has its interval, so it can be used again
+	if (!insertedObject.hasInterval) {
+		Interval interval;
+		interval.minX = circleCollider.position.x - circleCollider.radius;
+		interval.object = objectIndex;
+		_intervals.emplace_back(interval);
+		insertedObject.hasInterval = true;
+	}
+	if (circleCollider.radius > _largestRadius) {
+		_largestRadius = circleCollider.radius;
+	}
+	_objectCount++;
+	_intervalsSorted = false;
+	return objectIndex;
+}
+
+//The interval is moved to its new place the next time the list is sorted
+template<typename T>
+inline int SweepAndPrune<T>::Update(int handle, T object, Circle circleCollider) {
+	if (handle < 0 || handle >= (int)_objectsInserted.size() || !_objectsInserted[handle].active) {
+		return Insert(object, circleCollider);
+	}
+	_objectsInserted[handle].circleCollider = circleCollider;
+	if (circleCollider.radius > _largestRadius) {
+		_largestRadius = circleCollider.radius;
+	}
+	_intervalsSorted = false;
+	return handle;
+}
+
+template<typename T>
+inline void SweepAndPrune<T>::Remove(int handle) {
+	if (handle < 0 || handle >= (int)_objectsInserted.size() || !_objectsInserted[handle].active) {
+		return;
+	}
+	_objectsInserted[handle].active = false;
+	_objectsInserted[handle].object = T();
+	_objectsInserted[handle].nextFreeObject = _firstFreeObject;
+	_firstFreeObject = handle;
+	_objectCount--;
+	_intervalsSorted = false;
+}
+
+template<typename T>
+inline std::vector<T> SweepAndPrune<T>::Query(Circle range) {
+	std::vector<T> objectsFound;
+	Query(range, objectsFound);
+	return objectsFound;
+}
+
+template<typename T>
+inline void SweepAndPrune<T>::Query(Circle range, std::vector<T>& objectsFound) {
+	objectsFound.clear();
+	ForEachInRange(range, [&objectsFound](const T& object, const Circle& circleCollider) {
+		objectsFound.emplace_back(object);
+		return true;
+	});
+}
+
+template<typename T>
+inline bool SweepAndPrune<T>::Query(Circle range, QueryVisitor<T>& visitor) {
+	return ForEachInRange(range, [&visitor](const T& object, const Circle& circleCollider) {
+		return visitor.Visit(object, circleCollider);
+	});
+}
+
+template<typename T>
+inline void SweepAndPrune<T>::QueryRange(AABB range, std::vector<T>& objectsFound) {
+	objectsFound.clear();
+	ForEachInRange(range, [&objectsFound](const T& object, const Circle& circleCollider) {
+		objectsFound.emplace_back(object);
+		return true;
+	});
+}
+
+template<typename T>
+inline bool SweepAndPrune<T>::QueryRange(AABB range, QueryVisitor<T>& visitor) {
+	return ForEachInRange(range, [&visitor](const T& object, const Circle& circleCollider) {
+		return visitor.Visit(object, circleCollider);
+	});
+}
+
+//No interval is wider than the largest diameter, so the ones that start further to the left than that end before the range
+template<typename T>
+template<typename Range, typename Callback>
+inline bool SweepAndPrune<T>::ForEachInRange(Range range, Callback&& callback) {
+	SortIntervals();
+	const AABB bounds = RangeBounds(range);
+	for (unsigned int i = FindFirstInterval(bounds.min.x - _largestRadius * 2.f); i < _intervals.size() && _intervals[i].minX <= bounds.max.x; i++) {
+		const InsertedObject& insertedObject = _objectsInserted[_intervals[i].object];
+		if (RangeIntersect(range, insertedObject.circleCollider)) {
+			if (!callback(insertedObject.object, insertedObject.circleCollider)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/*Walks out to the right and then to the left from the position.
+The center of an object is never left of where its interval starts, and never more than the largest radius to the right of it*/
+template<typename T>
+inline void SweepAndPrune<T>::QueryNearest(Vector2<float> position, unsigned int k, float maxRadius, std::vector<NearestObject<T>>& nearestObjects) {
+	nearestObjects.clear();
+	SortIntervals();
+	const unsigned int firstInterval = FindFirstInterval(position.x);
+	for (unsigned int i = firstInterval; i < _intervals.size(); i++) {
+		if (_intervals[i].minX > position.x + NearestCutoff(nearestObjects, k, maxRadius)) {
+			break;
+		}
+		const InsertedObject& insertedObject = _objectsInserted[_intervals[i].object];
+		const float distance = Vector2<float>::distanceBetweenVectors(position, insertedObject.circleCollider.position);
+		if (distance <= maxRadius) {
+			AddNearestObject(nearestObjects, k, insertedObject.object, insertedObject.circleCollider, distance);
+		}
+	}
+	for (unsigned int i = firstInterval; i > 0; i--) {
+		if (_intervals[i - 1].minX + _largestRadius < position.x - NearestCutoff(nearestObjects, k, maxRadius)) {
+			break;
+		}
+		const InsertedObject& insertedObject = _objectsInserted[_intervals[i - 1].object];
+		const float distance = Vector2<float>::distanceBetweenVectors(position, insertedObject.circleCollider.position);
+		if (distance <= maxRadius) {
+			AddNearestObject(nearestObjects, k, insertedObject.object, insertedObject.circleCollider, distance);
+		}
+	}
+}
+
+//Checks every interval that overlaps the part of the x axis the ray covers
+template<typename T>
+inline RayHit<T> SweepAndPrune<T>::QueryRay(Ray ray) {
+	RayHit<T> rayHit;
+	if (ray.direction.x == 0.f && ray.direction.y == 0.f) {
+		return rayHit;
+	}
+	ray.direction.normalize();
+	SortIntervals();
+	const Vector2<float> rayEnd = ray.startPosition + ray.direction * ray.length;
+	const float minX = ray.startPosition.x < rayEnd.x ? ray.startPosition.x : rayEnd.x;
+	const float maxX = ray.startPosition.x > rayEnd.x ? ray.startPosition.x : rayEnd.x;
+	for (unsigned int i = FindFirstInterval(minX - _largestRadius * 2.f); i < _intervals.size() && _intervals[i].minX <= maxX; i++) {
+		const InsertedObject& insertedObject = _objectsInserted[_intervals[i].object];
+		SetClosestRayHit(rayHit, ray, insertedObject.object, insertedObject.circleCollider);
+	}
+	return rayHit;
+}
+
+/*The colliders are sorted by their left edge the same way as the intervals, starting from the order of the last call.
+Since both lists are sorted, the intervals that end before one collider starts can't reach any of the colliders after it,
+so the first interval to check only ever moves forward*/
+template<typename T>
+inline void SweepAndPrune<T>::QueryPairs(const std::vector<Circle>& circleColliders, std::vector<CollisionPair<T>>& pairs) {
+	pairs.clear();
+	SortIntervals();
+
+	//Colliders that no longer exist are dropped, and new ones are added at the end
+	unsigned int orderCount = 0;
+	for (unsigned int i = 0; i < _queryOrder.size(); i++) {
+		if (_queryOrder[i] < circleColliders.size()) {
+			_queryOrder[orderCount++] = _queryOrder[i];
+		}
+	}
+	_queryOrder.resize(orderCount);
+	for (unsigned int i = orderCount; i < circleColliders.size(); i++) {
+		_queryOrder.emplace_back(i);
+	}
+	for (unsigned int i = 1; i < _queryOrder.size(); i++) {
+		const unsigned int queryIndex = _queryOrder[i];
+		const float minX = circleColliders[queryIndex].position.x - circleColliders[queryIndex].radius;
+		unsigned int j = i;
+		while (j > 0 && circleColliders[_queryOrder[j - 1]].position.x - circleColliders[_queryOrder[j - 1]].radius > minX) {
+			_queryOrder[j] = _queryOrder[j - 1];
+			j--;
+			_sortMoves++;
+		}
+		_queryOrder[j] = queryIndex;
+	}
+
+	unsigned int firstInterval = 0;
+	for (unsigned int i = 0; i < _queryOrder.size(); i++) {
+		const Circle& circleCollider = circleColliders[_queryOrder[i]];
+		const float minX = circleCollider.position.x - circleCollider.radius;
+		const float maxX = circleCollider.position.x + circleCollider.radius;
+		while (firstInterval < _intervals.size() && _intervals[firstInterval].minX + _largestRadius * 2.f < minX) {
+			firstInterval++;
+		}
+		for (unsigned int j = firstInterval; j < _intervals.size() && _intervals[j].minX <= maxX; j++) {
+			const InsertedObject& insertedObject = _objectsInserted[_intervals[j].object];
+			if (RangeIntersect(circleCollider, insertedObject.circleCollider)) {
+				CollisionPair<T> collisionPair;
+				collisionPair.queryIndex = _queryOrder[i];
+				collisionPair.object = insertedObject.object;
+				collisionPair.circleCollider = insertedObject.circleCollider;
+				pairs.emplace_back(collisionPair);
+			}
+		}
+	}
+}
+
+template<typename T>
+inline void SweepAndPrune<T>::Clear() {
+	_objectsInserted.clear();
+	_intervals.clear();
+	_queryOrder.clear();
+	_largestRadius = 0.f;
+	_objectCount = 0;
+	_firstFreeObject = -1;
+	_intervalsSorted = true;
+}
+
+template<typename T>
+inline void SweepAndPrune<T>::EndFrame() {
+	_lastFrameSortMoves = _sortMoves;
+	_sortMoves = 0;
+}
+
+template<typename T>
+inline void SweepAndPrune<T>::Render() {
+	SortIntervals();
+	for (unsigned int i = 0; i < _intervals.size(); i++) {
+		const Circle& circleCollider = _objectsInserted[_intervals[i].object].circleCollider;
+		debugDrawer->AddDebugRectangle(DebugChannel::SpatialIndex, circleCollider.position,
+			Vector2<float>(circleCollider.position.x - circleCollider.radius, circleCollider.position.y - circleCollider.radius),
+			Vector2<float>(circleCollider.position.x + circleCollider.radius, circleCollider.position.y + circleCollider.radius), { 255, 125, 0, 255 });
+	}
+}
+
+template<typename T>
+inline const unsigned int SweepAndPrune<T>::GetObjectCount() const {
+	return _objectCount;
+}
+
+template<typename T>
+inline const unsigned int SweepAndPrune<T>::GetLastFrameSortMoves() const {
+	return _lastFrameSortMoves;
+}
+
+/*Moves the left edges over from the colliders and drops the intervals of removed objects in the same pass,
+then insertion sorts the list. The largest radius is found again too, so it shrinks when the big objects are gone*/
+template<typename T>
+inline void SweepAndPrune<T>::SortIntervals() {
+	if (_intervalsSorted) {
+		return;
+	}
+	unsigned int intervalCount = 0;
+	_largestRadius = 0.f;
+	for (unsigned int i = 0; i < _intervals.size(); i++) {
+		InsertedObject& insertedObject = _objectsInserted[_intervals[i].object];
+		if (!insertedObject.active) {
+			insertedObject.hasInterval = false;
+			continue;
+		}
+		_intervals[intervalCount].object = _intervals[i].object;
+		_intervals[intervalCount].minX = insertedObject.circleCollider.position.x - insertedObject.circleCollider.radius;
+		if (insertedObject.circleCollider.radius > _largestRadius) {
+			_largestRadius = insertedObject.circleCollider.radius;
+		}
+		intervalCount++;
+	}
+	_intervals.resize(intervalCount);
+
+	for (unsigned int i = 1; i < _intervals.size(); i++) {
+		const Interval interval = _intervals[i];
+		unsigned int j = i;
+		while (j > 0 && _intervals[j - 1].minX > interval.minX) {
+			_intervals[j] = _intervals[j - 1];
+			j--;
+			_sortMoves++;
+		}
+		_intervals[j] = interval;
+	}
+	_intervalsSorted = true;
+}
+
+template<typename T>
+inline const unsigned int SweepAndPrune<T>::FindFirstInterval(float positionX) const {
+	unsigned int low = 0;
+	unsigned int high = _intervals.size();
+	while (low < high) {
+		const unsigned int mid = low + (high - low) / 2;
+		if (_intervals[mid].minX < positionX) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	return low;
+}
@@ -1,17 +1,18 @@
 #include "textSprite.h"
+#include "fontRegistry.h"
 #include "gameEngine.h"
 
 #include <SDL2/SDL.h>
 
+//The font and its glyphs are only loaded the first time they are asked for, after that nothing the text sprite does makes a surface or texture
 void TextSprite::Init(const char* fontType, int fontSize, const char* text, SDL_Color color) {
-	_font = TTF_OpenFont(fontType, fontSize);
-	_textSurface = TTF_RenderText_Solid(_font, text, color);
-	_textTexture = SDL_CreateTextureFromSurface(renderer, _textSurface);
+	_font = fontRegistry->GetFont(fontType, fontSize);
+	ChangeText(text, color);
 }
 
 void TextSprite::ChangeText(const char* text, SDL_Color color) {
-	_textSurface = TTF_RenderText_Solid(_font, text, color);
-	_textTexture = SDL_CreateTextureFromSurface(renderer, _textSurface);
+	_text = text;
+	_color = color;
 }
 
 void TextSprite::SetTargetPosition(Vector2<float> position) {
@@ -20,16 +21,27 @@ void TextSprite::SetTargetPosition(Vector2<float> position) {
 }
 
 void TextSprite::ClearText() {
-	SDL_FreeSurface(_textSurface);
-	SDL_DestroyTexture(_textTexture);
+	_font = nullptr;
 }
 
 void TextSprite::Render() {
-	SDL_Rect textDst = { _posX, _posY, _textSurface->w, _textSurface->h };
-	SDL_RenderCopy(renderer, _textTexture, nullptr, &textDst);
+	RenderAt(_posX, _posY);
 }
 
 void TextSprite::RenderCentered() {
-	SDL_Rect textDist = { ((int)_posX - _textSurface->w / 2), _posY - _textSurface->h / 2, _textSurface->w, _textSurface->h };
-	SDL_RenderCopy(renderer, _textTexture, nullptr, &textDist);
+	if (!_font) {
+		return;
+	}
+	RenderAt(_posX - _font->glyphAtlas.GetTextWidth(_text) / 2, _posY - _font->glyphAtlas.GetLineHeight() / 2);
+}
+
+void TextSprite::RenderAt(float x, float y) {
+	if (!_font) {
+		return;
+	}
+	_font->glyphAtlas.AddText(_text, { x, y }, _color, _vertices, _indices);
+	if (_indices.empty()) {
+		return;
+	}
+	SDL_RenderGeometry(renderer, _font->glyphAtlas.GetTexture(), _vertices.data(), (int)_vertices.size(), _indices.data(), (int)_indices.size());
 }
@@ -4,28 +4,42 @@
 
 #include "vector2.h"
 
-class SDL_Surface;
-class SDL_Texture;
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Font;
 
 class TextSprite {
 public:
 	void Init(const char* fontType, int fontSize, const char* text, SDL_Color color);
 
+	//Only the text is changed, the quads are made from the glyph atlas when it's drawn
 	void ChangeText(const char* text, SDL_Color color);
 
 	void SetTargetPosition(Vector2<float> position);
 
+	//Lets go of the font, the font registry still has it
 	void ClearText();
 
 	void Render();
 	void RenderCentered();
 
 private:
-	TTF_Font* _font;
-	SDL_Surface * _textSurface;
-	SDL_Texture* _textTexture;
+	//Draws every character with one SDL_RenderGeometry call
+	void RenderAt(float x, float y);
+
+	//Shared with every text sprite with the same font and size
+	std::shared_ptr<Font> _font = nullptr;
+
+	std::string _text;
+	SDL_Color _color = { 255, 255, 255, 255 };
+
+	//Kept between draws so they don't have to be allocated again
+	std::vector<SDL_Vertex> _vertices;
+	std::vector<int> _indices;
 
-	float _posX;
-	float _posY;
+	float _posX = 0.f;
+	float _posY = 0.f;
 };
 
@@ -0,0 +1,112 @@
+#include "textureAtlas.h"
+
+#include "gameEngine.h"
+
+#include <filesystem>
+#include <vector>
+
+//ImGui builds its own copy of the rect packer as static functions, so this file gets one too
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "ImGui/imstb_rectpack.h"
+
+bool TextureAtlas::Build(const char* directory, int maxAtlasSize, int padding) {
+	Destroy();
+	std::vector<std::string> paths;
+	std::vector<SDL_Surface*> surfaces;
+	std::error_code error;
+	for (std::filesystem::directory_iterator it(directory, error); !error && it != std::filesystem::directory_iterator(); it.increment(error)) {
+		if (it->path().extension() != ".png") {
+			continue;
+		}
+		const std::string path = std::string(directory) + "/" + it->path().filename().string();
+		SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+		if (!loadedSurface) {
+			continue;
+		}
+		//Everything is copied as RGBA so the alpha ends up in the atlas as it is
+		SDL_Surface* surface = SDL_ConvertSurfaceFormat(loadedSurface, SDL_PIXELFORMAT_RGBA32, 0);
+		SDL_FreeSurface(loadedSurface);
+		if (!surface) {
+			continue;
+		}
+		paths.emplace_back(path);
+		surfaces.emplace_back(surface);
+	}
+	if (surfaces.empty()) {
+		return false;
+	}
+
+	std::vector<stbrp_rect> rects(surfaces.size());
+	for (unsigned int i = 0; i < surfaces.size(); i++) {
+		rects[i].id = (int)i;
+		rects[i].w = surfaces[i]->w + padding;
+		rects[i].h = surfaces[i]->h + padding;
+	}
+	int atlasSize = 256;
+	bool packed = false;
+	std::vector<stbrp_node> nodes;
+	while (!packed && atlasSize <= maxAtlasSize) {
+		nodes.resize(atlasSize);
+		stbrp_context context;
+		stbrp_init_target(&context, atlasSize, atlasSize, nodes.data(), (int)nodes.size());
+		packed = stbrp_pack_rects(&context, rects.data(), (int)rects.size()) == 1;
+		if (!packed) {
+			atlasSize *= 2;
+		}
+	}
+
+	if (packed) {
+		SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, atlasSize, atlasSize, 32, SDL_PIXELFORMAT_RGBA32);
+		for (unsigned int i = 0; i < rects.size(); i++) {
+			SDL_Rect destination = { rects[i].x, rects[i].y, surfaces[rects[i].id]->w, surfaces[rects[i].id]->h };
+			SDL_SetSurfaceBlendMode(surfaces[rects[i].id], SDL_BLENDMODE_NONE);
+			SDL_BlitSurface(surfaces[rects[i].id], NULL, atlasSurface, &destination);
+			_rects[paths[rects[i].id]] = destination;
+		}
+		_texture = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+		SDL_SetTextureBlendMode(_texture, SDL_BLENDMODE_BLEND);
+		_width = atlasSize;
+		_height = atlasSize;
+		SDL_FreeSurface(atlasSurface);
+	}
+	for (unsigned int i = 0; i < surfaces.size(); i++) {
+		SDL_FreeSurface(surfaces[i]);
+	}
+	if (!_texture) {
+		_rects.clear();
+		return false;
+	}
+	return true;
+}
+
+void TextureAtlas::Destroy() {
+	if (_texture) {
+		SDL_DestroyTexture(_texture);
+	}
+	_texture = nullptr;
+	_rects.clear();
+	_width = 0;
+	_height = 0;
+}
+
+bool TextureAtlas::GetRect(const std::string& path, SDL_Rect& rect) const {
+	std::unordered_map<std::string, SDL_Rect>::const_iterator it = _rects.find(path);
+	if (it == _rects.end()) {
+		return false;
+	}
+	rect = it->second;
+	return true;
+}
+
+SDL_Texture* TextureAtlas::GetTexture() const {
+	return _texture;
+}
+
+const int TextureAtlas::GetWidth() const {
+	return _width;
+}
+
+const int TextureAtlas::GetHeight() const {
+	return _height;
+}
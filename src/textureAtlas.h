@@ -0,0 +1,32 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include <string>
+#include <unordered_map>
+
+/*Packs every PNG in a folder into one texture when the game starts, so all the sprites drawn from it share a texture and can go in the same batch.
+The images are packed with the rect packer that comes with ImGui*/
+class TextureAtlas {
+public:
+	TextureAtlas() {}
+	~TextureAtlas() {}
+
+	/*Tries bigger and bigger square atlases until everything fits, up to maxAtlasSize.
+	Returns false if nothing was packed, then the sprites are loaded one texture each like before*/
+	bool Build(const char* directory, int maxAtlasSize = 4096, int padding = 1);
+	void Destroy();
+
+	//The path is the folder given to Build followed by the file name, the same path the sprite would be loaded with
+	bool GetRect(const std::string& path, SDL_Rect& rect) const;
+
+	SDL_Texture* GetTexture() const;
+	const int GetWidth() const;
+	const int GetHeight() const;
+
+private:
+	std::unordered_map<std::string, SDL_Rect> _rects;
+
+	SDL_Texture* _texture = nullptr;
+	int _width = 0;
+	int _height = 0;
+};
@@ -0,0 +1,121 @@
+#include "textureCache.h"
+#include "gameEngine.h"
+
+std::shared_ptr<Sprite> TextureCache::GetSprite(const char* path) {
+	std::weak_ptr<Sprite>& cachedSprite = _sprites[path];
+	std::shared_ptr<Sprite> sprite = cachedSprite.lock();
+	if (sprite) {
+		return sprite;
+	}
+	SDL_Rect atlasRect;
+	if (_textureAtlas.GetRect(path, atlasRect)) {
+		//The atlas texture belongs to the atlas, so this sprite only has to point at its part of it
+		sprite = std::make_shared<Sprite>();
+		sprite->texture = _textureAtlas.GetTexture();
+		sprite->x = atlasRect.x;
+		sprite->y = atlasRect.y;
+		sprite->w = atlasRect.w;
+		sprite->h = atlasRect.h;
+		sprite->textureWidth = _textureAtlas.GetWidth();
+		sprite->textureHeight = _textureAtlas.GetHeight();
+		sprite->path = path;
+		cachedSprite = sprite;
+		return sprite;
+	}
+	//The texture goes with the last shared pointer to the sprite
+	std::shared_ptr<bool> rendererAlive = _rendererAlive;
+	sprite = std::shared_ptr<Sprite>(new Sprite(), [rendererAlive](Sprite* sprite) {
+		if (*rendererAlive && sprite->texture) {
+			SDL_DestroyTexture(sprite->texture);
+		}
+		delete sprite;
+	});
+	sprite->Load(path);
+	sprite->path = path;
+	cachedSprite = sprite;
+	_loadCount++;
+	return sprite;
+}
+
+void TextureCache::SetPreRotationAngles(int angleCount) {
+	_preRotationAngles = angleCount > 0 ? angleCount : 0;
+}
+
+const int TextureCache::GetPreRotationAngles() const {
+	return _preRotationAngles;
+}
+
+std::shared_ptr<RotatedSprite> TextureCache::GetRotatedSprite(const char* path, int frameWidth, int frameHeight) {
+	if (_preRotationAngles == 0 || frameWidth <= 0 || frameHeight <= 0) {
+		return nullptr;
+	}
+	std::weak_ptr<RotatedSprite>& cachedRotatedSprite = _rotatedSprites[std::string(path) + ":" + std::to_string(frameWidth) + "x" + std::to_string(frameHeight)];
+	std::shared_ptr<RotatedSprite> rotatedSprite = cachedRotatedSprite.lock();
+	if (rotatedSprite) {
+		return rotatedSprite;
+	}
+	//The sprite is already cached when a sprite or sprite sheet asks for this, so it isn't loaded twice
+	std::shared_ptr<Sprite> sprite = GetSprite(path);
+	std::shared_ptr<bool> rendererAlive = _rendererAlive;
+	rotatedSprite = std::shared_ptr<RotatedSprite>(new RotatedSprite(), [rendererAlive](RotatedSprite* rotatedSprite) {
+		if (*rendererAlive) {
+			rotatedSprite->Destroy();
+		}
+		delete rotatedSprite;
+	});
+	if (!rotatedSprite->Build(renderer, sprite->texture, { sprite->x, sprite->y, frameWidth, frameHeight }, sprite->w / frameWidth, _preRotationAngles)) {
+		return nullptr;
+	}
+	cachedRotatedSprite = rotatedSprite;
+	return rotatedSprite;
+}
+
+bool TextureCache::BuildAtlas(const char* directory) {
+	if (!_textureAtlas.Build(directory)) {
+		return false;
+	}
+	_loadCount++;
+	return true;
+}
+
+void TextureCache::Shutdown() {
+	_textureAtlas.Destroy();
+	*_rendererAlive = false;
+}
+
+const unsigned int TextureCache::GetLoadCount() const {
+	return _loadCount;
+}
+
+unsigned int TextureCache::GetTextureCount() {
+	unsigned int textureCount = _textureAtlas.GetTexture() ? 1 : 0;
+	for (std::unordered_map<std::string, std::weak_ptr<Sprite>>::iterator it = _sprites.begin(); it != _sprites.end(); it++) {
+		std::shared_ptr<Sprite> sprite = it->second.lock();
+		if (sprite && sprite->texture != _textureAtlas.GetTexture()) {
+			textureCount++;
+		}
+	}
+	for (std::unordered_map<std::string, std::weak_ptr<RotatedSprite>>::iterator it = _rotatedSprites.begin(); it != _rotatedSprites.end(); it++) {
+		if (!it->second.expired()) {
+			textureCount++;
+		}
+	}
+	return textureCount;
+}
+
+unsigned int TextureCache::GetTextureBytes() {
+	unsigned int textureBytes = _textureAtlas.GetWidth() * _textureAtlas.GetHeight() * 4;
+	for (std::unordered_map<std::string, std::weak_ptr<Sprite>>::iterator it = _sprites.begin(); it != _sprites.end(); it++) {
+		std::shared_ptr<Sprite> sprite = it->second.lock();
+		if (sprite && sprite->texture != _textureAtlas.GetTexture()) {
+			textureBytes += sprite->w * sprite->h * 4;
+		}
+	}
+	for (std::unordered_map<std::string, std::weak_ptr<RotatedSprite>>::iterator it = _rotatedSprites.begin(); it != _rotatedSprites.end(); it++) {
+		std::shared_ptr<RotatedSprite> rotatedSprite = it->second.lock();
+		if (rotatedSprite) {
+			textureBytes += rotatedSprite->textureWidth * rotatedSprite->textureHeight * 4;
+		}
+	}
+	return textureBytes;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "rotatedSprite.h"
+#include "sprite.h"
+#include "textureAtlas.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/*Loads every texture once and gives the same sprite to everything that asks for the same path.
+The cache only keeps weak pointers, so the texture is destroyed once the last object using the sprite is gone,
+and it's loaded again if something asks for it after that*/
+class TextureCache {
+public:
+	TextureCache() {}
+	~TextureCache() {}
+
+	//Sprites in the atlas are given a part of the atlas texture, everything else is loaded from its own file
+	std::shared_ptr<Sprite> GetSprite(const char* path);
+	/*The sprites are pre-rotated at the given number of angles, 0 turns it off.
+	A sprite sheet gets its frames pre-rotated when it's loaded and a plain sprite the first time it's drawn with an orientation*/
+	void SetPreRotationAngles(int angleCount);
+	const int GetPreRotationAngles() const;
+	//Every frameWidth by frameHeight frame of the sprite pre-rotated, nullptr if pre-rotating is off or the renderer can't do it
+	std::shared_ptr<RotatedSprite> GetRotatedSprite(const char* path, int frameWidth, int frameHeight);
+	//Has to be done before any sprites in the folder are asked for, otherwise they already have their own textures
+	bool BuildAtlas(const char* directory);
+	//Destroys the atlas, and after that no texture is destroyed by the sprites anymore, since the renderer is about to go with all of them
+	void Shutdown();
+
+	//How many times a texture has actually been loaded from a file
+	const unsigned int GetLoadCount() const;
+	//The textures that are still used by something, the atlas counts as one
+	unsigned int GetTextureCount();
+	//What the textures that are still used take up, counted as four bytes a pixel
+	unsigned int GetTextureBytes();
+
+private:
+	std::unordered_map<std::string, std::weak_ptr<Sprite>> _sprites;
+	//Keyed by the path and the frame size
+	std::unordered_map<std::string, std::weak_ptr<RotatedSprite>> _rotatedSprites;
+	int _preRotationAngles = 0;
+
+	TextureAtlas _textureAtlas;
+	//Shared with the deleters of the sprites
+	std::shared_ptr<bool> _rendererAlive = std::make_shared<bool>(true);
+
+	unsigned int _loadCount = 0;
+};
@@ -0,0 +1,48 @@
+#include "visibilityCuller.h"
+#include "gameEngine.h"
+#include "imGuiManager.h"
+
+VisibilityCuller::VisibilityCuller(float margin) {
+	_screenRange = AABB::makeFromPositionSize(Vector2<float>(windowWidth * 0.5f, windowHeight * 0.5f), windowHeight + margin * 2.f, windowWidth + margin * 2.f);
+}
+
+void VisibilityCuller::Cull(CollisionLayer collisionLayer, unsigned int activeObjects) {
+	_cullingLayer = (unsigned int)collisionLayer;
+	_cullStamp++;
+	_visibleObjects[_cullingLayer].clear();
+	objectBaseQuadTree->QueryRange(_screenRange, LayerBit(collisionLayer), *this);
+	const unsigned int drawnObjects = _visibleObjects[_cullingLayer].size();
+	_culledCounts[_cullingLayer] = activeObjects > drawnObjects ? activeObjects - drawnObjects : 0;
+}
+
+/*The index can be a frame behind the objects, and the quadtree that is rebuilt every frame keeps removed objects until the end of the frame,
+so where the object is now is checked as well. A despawned object has been moved far away from the screen.
+An object that was despawned and spawned again in the same frame is in there twice, the stamp makes sure it's only added once*/
+bool VisibilityCuller::Visit(const std::shared_ptr<ObjectBase>& object, const Circle& circleCollider) {
+	if (object->GetCullStamp() == _cullStamp) {
+		return true;
+	}
+	const Vector2<float> position = object->GetPosition();
+	if (position.x >= _screenRange.min.x && position.x <= _screenRange.max.x && position.y >= _screenRange.min.y && position.y <= _screenRange.max.y) {
+		object->SetCullStamp(_cullStamp);
+		_visibleObjects[_cullingLayer].emplace_back(object);
+	}
+	return true;
+}
+
+const std::vector<std::shared_ptr<ObjectBase>>& VisibilityCuller::GetVisibleObjects(CollisionLayer collisionLayer) const {
+	return _visibleObjects[(unsigned int)collisionLayer];
+}
+
+const unsigned int VisibilityCuller::GetDrawnCount(CollisionLayer collisionLayer) const {
+	return _visibleObjects[(unsigned int)collisionLayer].size();
+}
+
+const unsigned int VisibilityCuller::GetCulledCount(CollisionLayer collisionLayer) const {
+	return _culledCounts[(unsigned int)collisionLayer];
+}
+
+void VisibilityCuller::ShowStatistics() {
+	imGuiHandler->ShowCulling("Culling", "Enemies", GetDrawnCount(CollisionLayer::Enemy), GetCulledCount(CollisionLayer::Enemy));
+	imGuiHandler->ShowCulling("Culling", "Projectiles", GetDrawnCount(CollisionLayer::Projectile), GetCulledCount(CollisionLayer::Projectile));
+}
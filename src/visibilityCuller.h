@@ -0,0 +1,38 @@
+#pragma once
+#include "collision.h"
+#include "layeredSpatialIndex.h"
+#include "objectBase.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+/*Finds the objects of a collision layer that are on the screen with one range query against the screen rectangle,
+so the managers only draw those instead of everything they have spawned.
+It's done once a frame after everything has been updated, and the pause state draws the last ones that were found since nothing moves while it's paused*/
+class VisibilityCuller : public QueryVisitor<std::shared_ptr<ObjectBase>> {
+public:
+	//The screen is grown by the margin, so sprites that are bigger than their colliders aren't cut off at the edges
+	VisibilityCuller(float margin = 64.f);
+	~VisibilityCuller() {}
+
+	//Replaces the visible objects of the layer, every active object that isn't found is counted as culled
+	void Cull(CollisionLayer collisionLayer, unsigned int activeObjects);
+	bool Visit(const std::shared_ptr<ObjectBase>& object, const Circle& circleCollider) override;
+
+	const std::vector<std::shared_ptr<ObjectBase>>& GetVisibleObjects(CollisionLayer collisionLayer) const;
+	const unsigned int GetDrawnCount(CollisionLayer collisionLayer) const;
+	const unsigned int GetCulledCount(CollisionLayer collisionLayer) const;
+
+	void ShowStatistics();
+
+private:
+	std::array<std::vector<std::shared_ptr<ObjectBase>>, (unsigned int)CollisionLayer::Count> _visibleObjects;
+	std::array<unsigned int, (unsigned int)CollisionLayer::Count> _culledCounts = {};
+
+	AABB _screenRange;
+	//The layer that is being queried, Visit adds what it finds to it
+	unsigned int _cullingLayer = 0;
+	//Goes up with every Cull, an object that already has it has been added in this pass
+	unsigned int _cullStamp = 0;
+};
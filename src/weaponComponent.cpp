@@ -6,11 +6,11 @@
 #include "playerCharacter.h"
 #include "projectileManager.h"
 #include "sprite.h"
+#include "textureCache.h"
 #include "timerManager.h"
 
 SwordComponent::SwordComponent() {
-	_sprite = std::make_shared<Sprite>();
-	_sprite->Load("res/sprites/Sword.png");
+	_sprite = textureCache->GetSprite("res/sprites/Sword.png");
 	_attackCooldownTimer = timerManager->CreateTimer(0.75f);
 	_chargeAttackTimer = timerManager->CreateTimer(0.25f);
 	_attackDamage = 2;
@@ -56,8 +56,7 @@ const WeaponType SwordComponent::GetWeaponType() const {
 }
 
 StaffComponent::StaffComponent() {
-	_sprite = std::make_shared<Sprite>();
-	_sprite->Load("res/sprites/Staff.png");
+	_sprite = textureCache->GetSprite("res/sprites/Staff.png");
 
 	_attackCooldownTimer = timerManager->CreateTimer(1.0f);
 	_chargeAttackTimer = timerManager->CreateTimer(0.5f);